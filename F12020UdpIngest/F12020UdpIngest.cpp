@@ -0,0 +1,409 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+// Headless UDP ingest for Linux hosts with F12020UdpReceiver (recvmmsg, see F12020UdpReceiver.h),
+// the sessions of all game instances sending to the port are parsed by a F12020SessionDemux.
+// usage: F12020UdpIngest listen [port] [--relay <address:port[/id,id,...][@rate]>]...
+//   receives the game streams (default port 20777) and prints the receive and session statistics
+//   every second while packets arrive, until Ctrl+C. Each --relay forwards the datagrams to one more endpoint
+//   (F12020UdpRelay, see F12020RelayDestination::Parse for the format), e.g. to the board on a Windows machine.
+// usage: F12020UdpIngest loopback <capture.f1cap> [sources]
+//   sends the packets of a capture from each of sources sockets (default 1) to 127.0.0.1 and receives them again.
+//   Checks that every datagram arrives unchanged and in order, that the receiver takes several datagrams per recvmmsg
+//   call, that each one carries a kernel receive timestamp (SO_TIMESTAMPNS) and that Stop() ends Run() right away
+//   (eventfd), with or without Run() blocking already. Each source is a session of its own in the demux, its final
+//   state must equal a direct replay of the capture and it must be evicted once idle.
+//   With a dozen sources and -fsanitize=thread this is the race check of the receiver and the demux.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "F12020Capture.h"
+#include "F12020SessionDemux.h"
+#include "F12020SessionEngine.h"
+#include "F12020UdpReceiver.h"
+#include "F12020UdpRelay.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+   constexpr uint16_t GAME_PORT = 20777;
+   constexpr int64_t REPORT_INTERVAL_NS = 1000000000;
+   constexpr unsigned LOOPBACK_IN_FLIGHT = 256;           // sent but not received yet, stays well below the receive buffer
+   constexpr unsigned LOOPBACK_MAX_SOURCES = 64;
+   constexpr int64_t LOOPBACK_IDLE_TIMEOUT_NS = 1000000000; // demux idle timeout of the loopback sessions
+   constexpr int64_t MAX_STOP_NS = 100000000;             // Stop() must end Run() within this
+
+   F12020UdpReceiver* s_receiver = nullptr;
+
+   void OnSignal(int)
+   {
+      if (s_receiver)
+         s_receiver->Stop(); // only writes the eventfd, async signal safe
+   }
+
+   int64_t Elapsed(std::chrono::steady_clock::time_point since)
+   {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - since).count();
+   }
+
+   void PrintStats(const F12020ReceiverStats& stats)
+   {
+      printf("  datagrams : %llu in %llu batches (%.1f per recvmmsg), %llu truncated\n",
+         static_cast<unsigned long long>(stats.datagrams), static_cast<unsigned long long>(stats.batches),
+         stats.batches ? static_cast<double>(stats.datagrams) / stats.batches : 0, static_cast<unsigned long long>(stats.truncated));
+   }
+
+   void PrintStats(const F12020SessionDemuxStats& stats)
+   {
+      printf("  sessions  : %u live, %llu evicted (%llu ended, %llu idle), %u workers\n", stats.sessions,
+         static_cast<unsigned long long>(stats.evictedEnded + stats.evictedIdle), static_cast<unsigned long long>(stats.evictedEnded),
+         static_cast<unsigned long long>(stats.evictedIdle), stats.workers);
+      printf("  packets   : %llu parsed, %llu rejected, %llu dropped\n", static_cast<unsigned long long>(stats.processed),
+         static_cast<unsigned long long>(stats.rejected), static_cast<unsigned long long>(stats.dropped));
+   }
+
+   void PrintStats(const F12020UdpRelay& relay)
+   {
+      for (unsigned i = 0; i < relay.Destinations(); ++i)
+      {
+         const F12020RelayStats stats = relay.Stats(i);
+         printf("  relay %u   : %llu sent, %llu filtered, %llu over the rate, %llu failed\n", i,
+            static_cast<unsigned long long>(stats.sent), static_cast<unsigned long long>(stats.filtered),
+            static_cast<unsigned long long>(stats.limited), static_cast<unsigned long long>(stats.failed));
+      }
+   }
+
+   int Listen(uint16_t port, const std::vector<F12020RelayDestination>& destinations)
+   {
+      F12020UdpReceiver receiver;
+      if (!receiver.Open(port))
+      {
+         printf("cannot bind port %u: %s\n", port, strerror(errno));
+         return 1;
+      }
+
+      F12020UdpRelay relay;
+      for (const auto& destination : destinations)
+      {
+         if (!relay.AddDestination(destination))
+         {
+            printf("cannot open the relay socket or more than %u destinations\n", F12020_RELAY_MAX_DESTINATIONS);
+            return 1;
+         }
+      }
+      if (relay.Destinations())
+         receiver.SetRelay(&relay);
+
+      s_receiver = &receiver;
+      signal(SIGINT, OnSignal);
+      signal(SIGTERM, OnSignal);
+      printf("listening on port %u, Ctrl+C to stop\n", receiver.Port());
+
+      F12020SessionDemux demux(nullptr);
+      int64_t nextReport = 0;
+      const bool ok = receiver.Run([&](const F12020ReceivedPacket& packet)
+      {
+         demux.Dispatch(packet.data, packet.len, packet.source);
+
+         // the kernel timestamp saves a clock read per packet
+         if (packet.timestampNs < nextReport)
+            return;
+         nextReport = packet.timestampNs + REPORT_INTERVAL_NS;
+         PrintStats(receiver.Stats());
+         PrintStats(demux.Stats());
+         PrintStats(relay);
+      });
+
+      s_receiver = nullptr;
+      printf("stopped\n");
+      PrintStats(receiver.Stats());
+      PrintStats(demux.Stats());
+      PrintStats(relay);
+      return ok ? 0 : 1;
+   }
+
+   // final state of a direct replay of each session (SaveState)
+   std::map<uint64_t, std::vector<uint8_t>> Replay(const std::vector<F12020CapturePacket>& packets)
+   {
+      std::map<uint64_t, std::unique_ptr<F12020SessionEngine>> engines;
+      for (const auto& packet : packets)
+      {
+         F12020PacketView view = F12020ElementaryParser::Inspect(packet.data, packet.len);
+         if (!view)
+            continue;
+
+         auto& engine = engines[view.header->m_sessionUID];
+         if (!engine)
+            engine.reset(new F12020SessionEngine());
+         engine->ProceedPacket(packet.data, packet.len);
+      }
+
+      std::map<uint64_t, std::vector<uint8_t>> references;
+      for (auto& engine : engines)
+      {
+         engine.second->FlushFrame();
+         engine.second->SaveState(references[engine.first]);
+      }
+      return references;
+   }
+
+   int Loopback(F12020CaptureReader& reader, unsigned sources)
+   {
+      std::vector<F12020CapturePacket> packets;
+      F12020CapturePacket packet;
+      reader.Rewind();
+      while (reader.Next(packet))
+      {
+         if (packet.len <= F12020_RING_SLOT_SIZE)
+            packets.push_back(packet);
+      }
+      if (packets.empty())
+      {
+         printf("the capture has no packets\n");
+         return 1;
+      }
+      const std::map<uint64_t, std::vector<uint8_t>> references = Replay(packets);
+
+      F12020UdpReceiver receiver;
+      if (!receiver.Open(0, "127.0.0.1"))
+      {
+         printf("cannot open the loopback receiver: %s\n", strerror(errno));
+         return 1;
+      }
+
+      sockaddr_in target{};
+      target.sin_family = AF_INET;
+      target.sin_port = htons(receiver.Port());
+      target.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+      // one socket per source, bound to know the source the receiver reports for it
+      std::vector<int> senders;
+      std::vector<uint64_t> senderSources;
+      for (unsigned k = 0; k < sources; ++k)
+      {
+         int sender = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+         sockaddr_in local{};
+         local.sin_family = AF_INET;
+         local.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+         socklen_t localLen = sizeof(local);
+         if ((sender < 0) || bind(sender, reinterpret_cast<sockaddr*>(&local), sizeof(local)) ||
+            getsockname(sender, reinterpret_cast<sockaddr*>(&local), &localLen))
+         {
+            printf("cannot open the loopback senders: %s\n", strerror(errno));
+            return 1;
+         }
+         senders.push_back(sender);
+         senderSources.push_back((static_cast<uint64_t>(INADDR_LOOPBACK) << 16) | ntohs(local.sin_port));
+      }
+
+      // demux observer (worker threads): compare the final state of each session to the direct replay
+      std::mutex sessionsMutex;
+      std::map<std::pair<uint64_t, uint64_t>, bool> sessionMatches; // by session UID and source
+      std::unique_ptr<F12020SessionDemux> demux(new F12020SessionDemux([&](const F12020SessionKey& key, const F12020SessionEngine& engine, bool final)
+      {
+         auto reference = references.find(key.sessionUID);
+         if (!final || (reference == references.end()))
+            return;
+
+         std::vector<uint8_t> state;
+         engine.SaveState(state);
+         std::lock_guard<std::mutex> lock(sessionsMutex);
+         sessionMatches[std::make_pair(key.sessionUID, key.source)] = (state == reference->second);
+      }, 0, LOOPBACK_IDLE_TIMEOUT_NS));
+
+      // receive thread: compare each datagram to the one sent at its position by its source, then dispatch it
+      std::atomic<size_t> received{ 0 };
+      std::vector<size_t> next(sources, 0);
+      size_t mismatches = 0;
+      size_t missingTimestamps = 0;
+      size_t outOfRangeTimestamps = 0;
+      const int64_t startNs = F12020CaptureNow();
+      bool runOk = false;
+
+      std::thread receiveThread([&]()
+      {
+         runOk = receiver.Run([&](const F12020ReceivedPacket& p)
+         {
+            const size_t k = std::find(senderSources.begin(), senderSources.end(), p.source) - senderSources.begin();
+            const size_t i = (k < sources) ? next[k]++ : packets.size();
+            if ((i >= packets.size()) || (p.len != packets[i].len) || memcmp(p.data, packets[i].data, p.len))
+               ++mismatches;
+
+            if (!p.timestampNs)
+               ++missingTimestamps;
+            else if ((p.timestampNs < startNs) || (p.timestampNs > F12020CaptureNow()))
+               ++outOfRangeTimestamps;
+
+            // retried if the worker queue is full, so the sessions see every packet like the direct replay
+            if (F12020ElementaryParser::Inspect(p.data, p.len))
+            {
+               while (!demux->Dispatch(p.data, p.len, p.source))
+                  std::this_thread::yield();
+            }
+
+            received.fetch_add(1, std::memory_order_release);
+         });
+      });
+
+      // round robin over the sources, like game instances sending at the same time
+      const auto sendStart = std::chrono::steady_clock::now();
+      const size_t total = packets.size() * sources;
+      size_t sent = 0;
+      size_t sendErrors = 0;
+      for (size_t i = 0; i < packets.size(); ++i)
+      {
+         for (unsigned k = 0; k < sources; ++k, ++sent)
+         {
+            while (sent - received.load(std::memory_order_acquire) >= LOOPBACK_IN_FLIGHT)
+               std::this_thread::yield();
+
+            if (sendto(senders[k], packets[i].data, packets[i].len, 0, reinterpret_cast<sockaddr*>(&target), sizeof(target)) < 0)
+               ++sendErrors;
+         }
+      }
+
+      // loopback does not lose datagrams below the receive buffer size, a second without progress means they are gone
+      size_t last = 0;
+      auto progress = std::chrono::steady_clock::now();
+      while (received.load(std::memory_order_acquire) < total - sendErrors)
+      {
+         if (received.load() != last)
+         {
+            last = received.load();
+            progress = std::chrono::steady_clock::now();
+         }
+         else if (Elapsed(progress) > REPORT_INTERVAL_NS)
+            break;
+         std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      const double seconds = Elapsed(sendStart) * 1e-9;
+
+      const auto stopStart = std::chrono::steady_clock::now();
+      receiver.Stop();
+      receiveThread.join();
+      const int64_t stopNs = Elapsed(stopStart);
+
+      // a Stop() before Run() must end the next Run() right away as well
+      const auto earlyStart = std::chrono::steady_clock::now();
+      receiver.Stop();
+      const bool earlyOk = receiver.Run([](const F12020ReceivedPacket&) {});
+      const int64_t earlyNs = Elapsed(earlyStart);
+      for (int sender : senders)
+         close(sender);
+
+      // all sessions are idle now, they must be evicted after the timeout and the next sweep
+      const size_t expectedSessions = references.size() * sources;
+      const auto evictStart = std::chrono::steady_clock::now();
+      F12020SessionDemuxStats demuxStats = demux->Stats();
+      while ((demuxStats.sessions || (demuxStats.evictedIdle + demuxStats.evictedEnded < expectedSessions)) &&
+         (Elapsed(evictStart) < 3 * LOOPBACK_IDLE_TIMEOUT_NS))
+      {
+         std::this_thread::sleep_for(std::chrono::milliseconds(10));
+         demuxStats = demux->Stats();
+      }
+      demux.reset();
+
+      size_t matched = 0;
+      for (const auto& session : sessionMatches)
+         matched += session.second ? 1 : 0;
+
+      const F12020ReceiverStats stats = receiver.Stats();
+      const size_t arrived = received.load();
+      printf("loopback (port %u, %u sources)\n", receiver.Port(), sources);
+      printf("  sent      : %zu datagrams in %.3f s, %zu send errors\n", total, seconds, sendErrors);
+      PrintStats(stats);
+      printf("  content   : %zu of %zu arrived, %zu differ or out of order\n", arrived, total, mismatches);
+      printf("  timestamp : %zu missing, %zu outside the run\n", missingTimestamps, outOfRangeTimestamps);
+      printf("  stop      : %.3f ms while blocked in Run(), %.3f ms before Run()\n", stopNs * 1e-6, earlyNs * 1e-6);
+      PrintStats(demuxStats); // dropped: the worker queue was full, the packet was dispatched again
+      printf("  replay    : %zu of %zu sessions equal the direct replay\n", matched, expectedSessions);
+
+      bool passed = true;
+      auto check = [&](bool condition, const char* what)
+      {
+         if (!condition)
+         {
+            printf("FAILED: %s\n", what);
+            passed = false;
+         }
+      };
+      check(runOk && earlyOk, "Run() reported a socket error");
+      check(!sendErrors && (arrived == total) && !mismatches, "not all datagrams arrived unchanged and in order");
+      check(stats.batches < stats.datagrams, "no recvmmsg call returned more than one datagram");
+      check(!missingTimestamps && !outOfRangeTimestamps, "datagrams without a valid kernel timestamp");
+      check((stopNs < MAX_STOP_NS) && (earlyNs < MAX_STOP_NS), "Stop() did not end Run() right away");
+      check(matched == expectedSessions, "a session differs from the direct replay");
+      check(!demuxStats.sessions && (demuxStats.evictedIdle + demuxStats.evictedEnded == expectedSessions), "idle sessions were not evicted");
+      printf(passed ? "passed\n" : "failed\n");
+      return passed ? 0 : 2;
+   }
+}
+
+int main(int argc, char* argv[])
+{
+   if ((argc > 1) && !strcmp(argv[1], "listen"))
+   {
+      uint16_t port = GAME_PORT;
+      std::vector<F12020RelayDestination> destinations;
+      for (int i = 2; i < argc; ++i)
+      {
+         if (!strcmp(argv[i], "--relay") && (i + 1 < argc))
+         {
+            F12020RelayDestination destination;
+            if (!destination.Parse(argv[++i]))
+            {
+               printf("%s: not a relay destination, address:port[/id,id,...][@rate]\n", argv[i]);
+               return 1;
+            }
+            destinations.push_back(destination);
+         }
+         else if (i == 2)
+            port = static_cast<uint16_t>(atoi(argv[i]));
+         else
+         {
+            printf("%s: unknown option\n", argv[i]);
+            return 1;
+         }
+      }
+      return Listen(port, destinations);
+   }
+
+   if ((argc > 2) && !strcmp(argv[1], "loopback"))
+   {
+      F12020CaptureReader reader;
+      if (!reader.Open(argv[2]))
+      {
+         printf("%s: not a readable capture\n", argv[2]);
+         return 1;
+      }
+
+      const int sources = (argc > 3) ? atoi(argv[3]) : 1;
+      if ((sources < 1) || (sources > static_cast<int>(LOOPBACK_MAX_SOURCES)))
+      {
+         printf("sources: 1 .. %u\n", LOOPBACK_MAX_SOURCES);
+         return 1;
+      }
+      return Loopback(reader, static_cast<unsigned>(sources));
+   }
+
+   printf("usage: F12020UdpIngest listen [port] [--relay <address:port[/id,id,...][@rate]>]...\n");
+   printf("       F12020UdpIngest loopback <capture.f1cap> [sources]\n");
+   return 1;
+}
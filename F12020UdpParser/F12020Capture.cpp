@@ -0,0 +1,502 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+// compiled without /clr, see F12020UdpParser.vcxproj
+
+#include "F12020Capture.h"
+#include "F12020SessionEngine.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+   constexpr size_t WRITE_BUFFER_SIZE = 256 * 1024;
+
+   FILE* OpenForWriting(const char* path)
+   {
+#ifdef _MSC_VER
+      FILE* file = nullptr;
+      if (fopen_s(&file, path, "wb"))
+         return nullptr;
+      return file;
+#else
+      return fopen(path, "wb");
+#endif
+   }
+}
+
+int64_t F12020CaptureNow()
+{
+   return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+F12020CaptureWriter::~F12020CaptureWriter()
+{
+   Close();
+}
+
+bool F12020CaptureWriter::Open(const char* path)
+{
+   Close();
+
+   m_file = OpenForWriting(path);
+   if (!m_file)
+      return false;
+   setvbuf(m_file, nullptr, _IOFBF, WRITE_BUFFER_SIZE);
+
+   F12020CaptureFileHeader header{};
+   memcpy(header.magic, F12020_CAPTURE_MAGIC, sizeof(header.magic));
+   header.version = F12020_CAPTURE_VERSION;
+   header.headerSize = sizeof(header);
+   header.createdNs = F12020CaptureNow();
+
+   m_ok = fwrite(&header, sizeof(header), 1, m_file) == 1;
+   m_offset = sizeof(header);
+   m_lastIndex = 0;
+   m_packets = 0;
+   m_pending.clear();
+   m_keyframes = false;
+   m_pending.reserve(F12020_CAPTURE_INDEX_BLOCK);
+   return m_ok;
+}
+
+bool F12020CaptureWriter::Write(const uint8_t* pData, unsigned len, int64_t timestampNs, uint64_t source)
+{
+   if (!m_file || !m_ok)
+      return false;
+
+   if (((m_packets % F12020_CAPTURE_INDEX_INTERVAL) == 0) && (len >= sizeof(PacketHeader)))
+   {
+      const auto& header = *reinterpret_cast<const PacketHeader*>(pData);
+      F12020CaptureIndexEntry entry;
+      entry.timestampNs = timestampNs;
+      entry.offset = m_offset;
+      entry.sessionTime = header.m_sessionTime;
+      entry.frameIdentifier = header.m_frameIdentifier;
+      m_pending.push_back(entry);
+   }
+
+   if (!m_WriteRecord(F12020_CAPTURE_PACKET, timestampNs, source, pData, len))
+      return false;
+   ++m_packets;
+
+   if (m_pending.size() >= F12020_CAPTURE_INDEX_BLOCK)
+      return m_WriteIndex();
+   return true;
+}
+
+bool F12020CaptureWriter::Close()
+{
+   if (!m_file)
+      return false;
+
+   if (!m_pending.empty())
+      m_WriteIndex();
+
+   F12020CaptureFooter footer;
+   footer.lastIndex = m_lastIndex;
+   footer.packets = m_packets;
+   m_WriteRecord(F12020_CAPTURE_FOOTER, F12020CaptureNow(), 0, &footer, sizeof(footer));
+
+   bool ok = m_ok && (fclose(m_file) == 0);
+   m_file = nullptr;
+   m_ok = false;
+   return ok;
+}
+
+bool F12020CaptureWriter::KeyframeDue(const PacketHeader& header) const
+{
+   return !m_keyframes || (header.m_sessionUID != m_keyframeSession) || (header.m_sessionTime < m_keyframeTime) ||
+      ((header.m_sessionTime - m_keyframeTime) >= F12020_CAPTURE_KEYFRAME_INTERVAL);
+}
+
+bool F12020CaptureWriter::WriteKeyframe(const PacketHeader& header, const uint8_t* pState, unsigned len, int64_t timestampNs)
+{
+   if (!m_file || !m_ok)
+      return false;
+
+   F12020CaptureIndexEntry entry;
+   entry.timestampNs = timestampNs;
+   entry.offset = m_offset;
+   entry.sessionTime = header.m_sessionTime;
+   entry.frameIdentifier = header.m_frameIdentifier;
+   m_pending.push_back(entry);
+
+   F12020CaptureKeyframe keyframe;
+   keyframe.sessionUID = header.m_sessionUID;
+   keyframe.sessionTime = header.m_sessionTime;
+   keyframe.frameIdentifier = header.m_frameIdentifier;
+   keyframe.packets = m_packets;
+   if (!m_WriteRecord(F12020_CAPTURE_KEYFRAME, timestampNs, 0, &keyframe, sizeof(keyframe), pState, len))
+      return false;
+
+   m_keyframes = true;
+   m_keyframeSession = header.m_sessionUID;
+   m_keyframeTime = header.m_sessionTime;
+
+   if (m_pending.size() >= F12020_CAPTURE_INDEX_BLOCK)
+      return m_WriteIndex();
+   return true;
+}
+
+bool F12020CaptureWriter::m_WriteRecord(uint16_t type, int64_t timestampNs, uint64_t source, const void* pData, unsigned len, const void* pTail, unsigned tailLen)
+{
+   F12020CaptureRecord record;
+   record.size = len + tailLen;
+   record.type = type;
+   record.flags = 0;
+   record.timestampNs = timestampNs;
+   record.source = source;
+
+   m_ok = m_ok && (fwrite(&record, sizeof(record), 1, m_file) == 1);
+   m_ok = m_ok && (!len || (fwrite(pData, len, 1, m_file) == 1));
+   m_ok = m_ok && (!tailLen || (fwrite(pTail, tailLen, 1, m_file) == 1));
+   m_offset += sizeof(record) + record.size;
+   return m_ok;
+}
+
+bool F12020CaptureWriter::m_WriteIndex()
+{
+   F12020CaptureIndexBlock block;
+   block.previous = m_lastIndex;
+   block.count = static_cast<uint32_t>(m_pending.size());
+   block.reserved = 0;
+
+   const uint64_t offset = m_offset;
+   bool ok = m_WriteRecord(F12020_CAPTURE_INDEX, 0, 0, &block, sizeof(block), m_pending.data(), block.count * sizeof(F12020CaptureIndexEntry));
+   m_lastIndex = offset;
+   m_pending.clear();
+   return ok;
+}
+
+F12020CaptureReader::~F12020CaptureReader()
+{
+   Close();
+}
+
+bool F12020CaptureReader::Open(const char* path)
+{
+   Close();
+
+#ifdef _WIN32
+   HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+   if (file == INVALID_HANDLE_VALUE)
+      return false;
+
+   LARGE_INTEGER size;
+   if (!GetFileSizeEx(file, &size) || (size.QuadPart < static_cast<LONGLONG>(sizeof(F12020CaptureFileHeader))))
+   {
+      CloseHandle(file);
+      return false;
+   }
+
+   // the view keeps the mapping alive, both handles can be closed right away
+   HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+   CloseHandle(file);
+   if (!mapping)
+      return false;
+   const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+   CloseHandle(mapping);
+   if (!data)
+      return false;
+
+   m_data = static_cast<const uint8_t*>(data);
+   m_size = static_cast<uint64_t>(size.QuadPart);
+#else
+   int fd = open(path, O_RDONLY | O_CLOEXEC);
+   if (fd < 0)
+      return false;
+
+   struct stat st;
+   if ((fstat(fd, &st) < 0) || (st.st_size < static_cast<off_t>(sizeof(F12020CaptureFileHeader))))
+   {
+      close(fd);
+      return false;
+   }
+
+   void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if (data == MAP_FAILED)
+      return false;
+   madvise(data, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+
+   m_data = static_cast<const uint8_t*>(data);
+   m_size = static_cast<uint64_t>(st.st_size);
+#endif
+
+   const auto& header = Header();
+   if (memcmp(header.magic, F12020_CAPTURE_MAGIC, sizeof(header.magic)) || (header.version != F12020_CAPTURE_VERSION) ||
+      (header.headerSize < sizeof(F12020CaptureFileHeader)) || (header.headerSize > m_size))
+   {
+      Close();
+      return false;
+   }
+
+   if (!m_LoadIndex())
+      m_ScanIndex();
+
+   Rewind();
+   return true;
+}
+
+void F12020CaptureReader::Close()
+{
+   if (m_data)
+   {
+#ifdef _WIN32
+      UnmapViewOfFile(m_data);
+#else
+      munmap(const_cast<uint8_t*>(m_data), static_cast<size_t>(m_size));
+#endif
+   }
+
+   m_data = nullptr;
+   m_size = 0;
+   m_pos = 0;
+   m_complete = false;
+   m_index.clear();
+   m_keyframes.clear();
+}
+
+bool F12020CaptureReader::Next(F12020CapturePacket& packet)
+{
+   while (const F12020CaptureRecord* record = m_Record(m_pos))
+   {
+      const uint64_t offset = m_pos;
+      m_pos += sizeof(F12020CaptureRecord) + record->size;
+
+      if (record->type != F12020_CAPTURE_PACKET)
+         continue;
+
+      packet.data = m_data + offset + sizeof(F12020CaptureRecord);
+      packet.len = record->size;
+      packet.timestampNs = record->timestampNs;
+      packet.source = record->source;
+      packet.offset = offset;
+      return true;
+   }
+
+   return false;
+}
+
+void F12020CaptureReader::Rewind()
+{
+   m_pos = m_data ? Header().headerSize : 0;
+}
+
+bool F12020CaptureReader::Seek(uint64_t offset)
+{
+   if (!m_data || (offset < Header().headerSize) || !m_Record(offset))
+      return false;
+
+   m_pos = offset;
+   return true;
+}
+
+bool F12020CaptureReader::SeekTimestamp(int64_t timestampNs)
+{
+   auto it = std::upper_bound(m_index.begin(), m_index.end(), timestampNs,
+      [](int64_t t, const F12020CaptureIndexEntry& entry) { return t < entry.timestampNs; });
+
+   if (it == m_index.begin())
+   {
+      Rewind();
+      return m_data != nullptr;
+   }
+
+   return Seek((it - 1)->offset);
+}
+
+bool F12020CaptureReader::SeekSessionTime(F12020SessionEngine& engine, uint64_t sessionUID, float sessionTime)
+{
+   if (!m_data)
+      return false;
+
+   if (const F12020CaptureKeyframeEntry* entry = FindKeyframe(sessionUID, sessionTime))
+   {
+      if (!RestoreKeyframe(*entry, engine))
+         return false;
+   }
+   else
+   {
+      engine = F12020SessionEngine();
+      Rewind();
+   }
+
+   // replay the tail, stop in front of the first packet of the session past sessionTime
+   F12020CapturePacket packet;
+   while (Next(packet))
+   {
+      if (packet.len >= sizeof(PacketHeader))
+      {
+         const auto& header = *reinterpret_cast<const PacketHeader*>(packet.data);
+         if ((header.m_sessionUID == sessionUID) && (header.m_sessionTime > sessionTime))
+         {
+            m_pos = packet.offset;
+            break;
+         }
+      }
+
+      engine.ProceedPacket(packet.data, packet.len);
+   }
+
+   engine.FlushFrame(); // the frame at sessionTime may continue after it
+   return true;
+}
+
+const F12020CaptureKeyframeEntry* F12020CaptureReader::FindKeyframe(uint64_t sessionUID, float sessionTime) const
+{
+   const F12020CaptureKeyframeEntry* first = nullptr;
+   const F12020CaptureKeyframeEntry* best = nullptr;
+   for (const auto& entry : m_keyframes)
+   {
+      if (entry.keyframe.sessionUID != sessionUID)
+         continue;
+
+      if (!first)
+         first = &entry;
+      if (entry.keyframe.sessionTime <= sessionTime)
+         best = &entry;
+   }
+
+   return best ? best : first;
+}
+
+bool F12020CaptureReader::RestoreKeyframe(const F12020CaptureKeyframeEntry& entry, F12020SessionEngine& engine)
+{
+   const F12020CaptureRecord* record = m_Record(entry.offset);
+   if (!record || (record->type != F12020_CAPTURE_KEYFRAME) || (record->size < sizeof(F12020CaptureKeyframe)))
+      return false;
+
+   const uint8_t* state = reinterpret_cast<const uint8_t*>(record + 1) + sizeof(F12020CaptureKeyframe);
+   if (!engine.RestoreState(state, record->size - sizeof(F12020CaptureKeyframe)))
+      return false;
+
+   m_pos = entry.offset + sizeof(F12020CaptureRecord) + record->size;
+   return true;
+}
+
+const F12020CaptureRecord* F12020CaptureReader::m_Record(uint64_t offset) const
+{
+   if ((offset > m_size) || ((m_size - offset) < sizeof(F12020CaptureRecord)))
+      return nullptr;
+
+   const auto* record = reinterpret_cast<const F12020CaptureRecord*>(m_data + offset);
+   if ((m_size - offset - sizeof(F12020CaptureRecord)) < record->size)
+      return nullptr;
+
+   return record;
+}
+
+bool F12020CaptureReader::m_LoadIndex()
+{
+   // the footer is the last record of a closed capture
+   constexpr uint64_t FOOTER_RECORD = sizeof(F12020CaptureRecord) + sizeof(F12020CaptureFooter);
+   if (m_size < Header().headerSize + FOOTER_RECORD)
+      return false;
+
+   const uint64_t footerOffset = m_size - FOOTER_RECORD;
+   const F12020CaptureRecord* record = m_Record(footerOffset);
+   if (!record || (record->type != F12020_CAPTURE_FOOTER) || (record->size != sizeof(F12020CaptureFooter)))
+      return false;
+
+   const auto& footer = *reinterpret_cast<const F12020CaptureFooter*>(record + 1);
+
+   // the index records are chained backwards
+   std::vector<uint64_t> blocks;
+   for (uint64_t offset = footer.lastIndex; offset; )
+   {
+      record = m_Record(offset);
+      if (!record || (record->type != F12020_CAPTURE_INDEX) || (record->size < sizeof(F12020CaptureIndexBlock)) || (offset >= footerOffset))
+         return false;
+
+      const auto& block = *reinterpret_cast<const F12020CaptureIndexBlock*>(record + 1);
+      if ((record->size - sizeof(block)) / sizeof(F12020CaptureIndexEntry) < block.count || (block.previous >= offset))
+         return false;
+
+      blocks.push_back(offset);
+      offset = block.previous;
+   }
+
+   m_index.clear();
+   m_keyframes.clear();
+   for (auto it = blocks.rbegin(); it != blocks.rend(); ++it)
+   {
+      record = m_Record(*it);
+      const auto& block = *reinterpret_cast<const F12020CaptureIndexBlock*>(record + 1);
+      const auto* entries = reinterpret_cast<const F12020CaptureIndexEntry*>(&block + 1);
+      for (uint32_t i = 0; i < block.count; ++i)
+         m_AddEntry(entries[i]);
+   }
+
+   m_complete = true;
+   return true;
+}
+
+void F12020CaptureReader::m_ScanIndex()
+{
+   // no footer: rebuild the index from the packet and keyframe records, same interval as the writer
+   m_index.clear();
+   m_keyframes.clear();
+   m_complete = false;
+
+   uint64_t packets = 0;
+   uint64_t offset = Header().headerSize;
+   while (const F12020CaptureRecord* record = m_Record(offset))
+   {
+      if (record->type == F12020_CAPTURE_PACKET)
+      {
+         if (((packets % F12020_CAPTURE_INDEX_INTERVAL) == 0) && (record->size >= sizeof(PacketHeader)))
+         {
+            const auto& header = *reinterpret_cast<const PacketHeader*>(record + 1);
+            F12020CaptureIndexEntry entry;
+            entry.timestampNs = record->timestampNs;
+            entry.offset = offset;
+            entry.sessionTime = header.m_sessionTime;
+            entry.frameIdentifier = header.m_frameIdentifier;
+            m_index.push_back(entry);
+         }
+         ++packets;
+      }
+      else if (record->type == F12020_CAPTURE_KEYFRAME)
+      {
+         F12020CaptureIndexEntry entry{};
+         entry.timestampNs = record->timestampNs;
+         entry.offset = offset;
+         m_AddEntry(entry);
+      }
+
+      offset += sizeof(F12020CaptureRecord) + record->size;
+   }
+}
+
+void F12020CaptureReader::m_AddEntry(const F12020CaptureIndexEntry& entry)
+{
+   const F12020CaptureRecord* record = m_Record(entry.offset);
+   if (!record)
+      return;
+
+   if (record->type == F12020_CAPTURE_PACKET)
+   {
+      m_index.push_back(entry);
+   }
+   else if ((record->type == F12020_CAPTURE_KEYFRAME) && (record->size >= sizeof(F12020CaptureKeyframe)))
+   {
+      F12020CaptureKeyframeEntry keyframe;
+      keyframe.offset = entry.offset;
+      keyframe.timestampNs = entry.timestampNs;
+      memcpy(&keyframe.keyframe, record + 1, sizeof(keyframe.keyframe));
+      m_keyframes.push_back(keyframe);
+   }
+}
@@ -0,0 +1,183 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+#include "F12020DataDefs.h"
+
+struct F12020SessionEngine;
+
+// Append only capture of the raw UDP stream, to reproduce sessions and to benchmark the parser offline.
+// File layout (little endian, packed):
+//   F12020CaptureFileHeader
+//   records, each one a F12020CaptureRecord followed by size bytes:
+//     packet: the datagram as received
+//     index:  F12020CaptureIndexBlock + count F12020CaptureIndexEntry, every F12020_CAPTURE_INDEX_BLOCK entries
+//     keyframe: F12020CaptureKeyframe + F12020SessionEngine::SaveState() after all preceding packets, indexed like the packets
+//     footer: F12020CaptureFooter, written by Close(). A capture without footer (crash) is still readable.
+// The reader maps the whole file, so the packets can be passed to F12020SessionEngine::ProceedPacket in place.
+// Seeking restores the nearest keyframe and replays only the packets after it.
+
+constexpr char F12020_CAPTURE_MAGIC[8] = { 'F', '1', 'C', 'A', 'P', '2', '0', '\0' };
+constexpr uint16_t F12020_CAPTURE_VERSION = 1;
+constexpr unsigned F12020_CAPTURE_INDEX_INTERVAL = 32; // packets per index entry
+constexpr unsigned F12020_CAPTURE_INDEX_BLOCK = 32;    // index entries per index record
+constexpr float F12020_CAPTURE_KEYFRAME_INTERVAL = 10;  // session seconds between keyframes
+
+enum F12020CaptureRecordType
+{
+   F12020_CAPTURE_PACKET = 1,
+   F12020_CAPTURE_INDEX = 2,
+   F12020_CAPTURE_FOOTER = 3,
+   F12020_CAPTURE_KEYFRAME = 4
+};
+
+#pragma pack(push, 1)
+struct F12020CaptureFileHeader
+{
+   char magic[8];       // F12020_CAPTURE_MAGIC
+   uint16_t version;    // F12020_CAPTURE_VERSION
+   uint16_t headerSize; // offset of the first record
+   uint32_t reserved;
+   int64_t createdNs;   // unix time in ns
+};
+
+struct F12020CaptureRecord
+{
+   uint32_t size;       // bytes following this record header
+   uint16_t type;       // F12020CaptureRecordType
+   uint16_t flags;
+   int64_t timestampNs; // packet: receive time (unix time in ns)
+   uint64_t source;     // packet: sender address, 0 if unknown
+};
+
+struct F12020CaptureIndexEntry
+{
+   int64_t timestampNs;
+   uint64_t offset;     // file offset of the packet or keyframe record
+   float sessionTime;   // PacketHeader::m_sessionTime of the packet
+   uint32_t frameIdentifier;
+};
+
+struct F12020CaptureIndexBlock
+{
+   uint64_t previous;   // file offset of the previous index record, 0 for the first one
+   uint32_t count;      // entries following
+   uint32_t reserved;
+};
+
+struct F12020CaptureKeyframe
+{
+   uint64_t sessionUID; // header of the last packet before the keyframe
+   float sessionTime;
+   uint32_t frameIdentifier;
+   uint64_t packets;    // packet records before the keyframe
+};
+
+struct F12020CaptureFooter
+{
+   uint64_t lastIndex;  // file offset of the last index record, 0 if none
+   uint64_t packets;
+};
+#pragma pack(pop)
+
+// unix time in ns, the clock used for the capture timestamps
+int64_t F12020CaptureNow();
+
+struct F12020CaptureWriter
+{
+   F12020CaptureWriter() = default;
+   ~F12020CaptureWriter();
+   F12020CaptureWriter(const F12020CaptureWriter&) = delete;
+   F12020CaptureWriter& operator=(const F12020CaptureWriter&) = delete;
+
+   bool Open(const char* path); // truncates an existing file
+   bool Write(const uint8_t* pData, unsigned len, int64_t timestampNs, uint64_t source = 0); // buffered, no syscall per packet
+   bool Close(); // writes the pending index and the footer
+
+   // keyframes: due for the first packet of a session and every F12020_CAPTURE_KEYFRAME_INTERVAL session seconds,
+   // header is the last packet written, pState the engine state after it
+   bool KeyframeDue(const PacketHeader& header) const;
+   bool WriteKeyframe(const PacketHeader& header, const uint8_t* pState, unsigned len, int64_t timestampNs);
+
+   bool IsOpen() const { return m_file != nullptr; }
+   uint64_t Packets() const { return m_packets; }
+
+private:
+   bool m_WriteRecord(uint16_t type, int64_t timestampNs, uint64_t source, const void* pData, unsigned len, const void* pTail = nullptr, unsigned tailLen = 0);
+   bool m_WriteIndex();
+
+   FILE* m_file{ nullptr };
+   bool m_ok{ false };
+   uint64_t m_offset{ 0 };    // file offset of the next record
+   uint64_t m_lastIndex{ 0 };
+   uint64_t m_packets{ 0 };
+   std::vector<F12020CaptureIndexEntry> m_pending; // entries not yet written
+   bool m_keyframes{ false }; // any keyframe written
+   uint64_t m_keyframeSession{ 0 };
+   float m_keyframeTime{ 0 };
+};
+
+struct F12020CapturePacket
+{
+   const uint8_t* data; // points into the mapping, valid until the reader is closed
+   unsigned len;
+   int64_t timestampNs;
+   uint64_t source;
+   uint64_t offset;     // file offset of the record
+};
+
+struct F12020CaptureKeyframeEntry
+{
+   uint64_t offset; // file offset of the keyframe record
+   int64_t timestampNs;
+   F12020CaptureKeyframe keyframe;
+};
+
+struct F12020CaptureReader
+{
+   F12020CaptureReader() = default;
+   ~F12020CaptureReader();
+   F12020CaptureReader(const F12020CaptureReader&) = delete;
+   F12020CaptureReader& operator=(const F12020CaptureReader&) = delete;
+
+   bool Open(const char* path); // maps the file read only and loads the index
+   void Close();
+
+   // next packet record, false at the end of the capture (or at a truncated record)
+   bool Next(F12020CapturePacket& packet);
+
+   void Rewind();
+   bool Seek(uint64_t offset); // continue at the record at offset, e.g. F12020CaptureIndexEntry::offset
+   bool SeekTimestamp(int64_t timestampNs); // continue at the last indexed packet at or before timestampNs
+
+   // bring engine to the state at sessionTime of the session: restore the nearest keyframe (or replay from the start
+   // with a new engine if the session has none), then replay the packets up to sessionTime. Continues after the last one.
+   bool SeekSessionTime(F12020SessionEngine& engine, uint64_t sessionUID, float sessionTime);
+
+   // last keyframe of the session at or before sessionTime, or the first one of the session, nullptr if none
+   const F12020CaptureKeyframeEntry* FindKeyframe(uint64_t sessionUID, float sessionTime) const;
+   bool RestoreKeyframe(const F12020CaptureKeyframeEntry& entry, F12020SessionEngine& engine); // continues after the keyframe
+
+   const F12020CaptureFileHeader& Header() const { return *reinterpret_cast<const F12020CaptureFileHeader*>(m_data); }
+   const std::vector<F12020CaptureIndexEntry>& Index() const { return m_index; } // packets only
+   const std::vector<F12020CaptureKeyframeEntry>& Keyframes() const { return m_keyframes; }
+   bool Complete() const { return m_complete; } // false if the footer is missing, the index was rebuilt by scanning
+   uint64_t Size() const { return m_size; }
+   uint64_t Position() const { return m_pos; }
+
+private:
+   const F12020CaptureRecord* m_Record(uint64_t offset) const; // nullptr if there is no complete record at offset
+   bool m_LoadIndex();
+   void m_ScanIndex();
+   void m_AddEntry(const F12020CaptureIndexEntry& entry); // sorts keyframes out of the index
+
+   const uint8_t* m_data{ nullptr };
+   uint64_t m_size{ 0 };
+   uint64_t m_pos{ 0 };
+   bool m_complete{ false };
+   std::vector<F12020CaptureIndexEntry> m_index;
+   std::vector<F12020CaptureKeyframeEntry> m_keyframes;
+};
@@ -0,0 +1,106 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "F12020CarStateStore.h"
+#include "F12020WheelDecoder.h"
+
+#include <stddef.h>
+
+namespace
+{
+   // address of the wheel array member of the first car
+   template<typename Packet>
+   const uint8_t* FirstCar(const Packet& packet, size_t carsOffset, size_t memberOffset)
+   {
+      return reinterpret_cast<const uint8_t*>(&packet) + carsOffset + memberOffset;
+   }
+}
+
+void F12020CarStateStore::ScatterLap(const PacketLapData& packet)
+{
+   for (int i = 0; i < F12020_MAX_CARS; ++i)
+   {
+      const LapData& src = packet.m_lapData[i];
+      position[i] = src.m_carPosition;
+      currentLapNum[i] = src.m_currentLapNum;
+      sector[i] = src.m_sector;
+      sector1TimeInMS[i] = src.m_sector1TimeInMS;
+      sector2TimeInMS[i] = src.m_sector2TimeInMS;
+      lastLapTime[i] = src.m_lastLapTime;
+      bestLapTime[i] = src.m_bestLapTime;
+      pitStatus[i] = src.m_pitStatus;
+      driverStatus[i] = src.m_driverStatus;
+      resultStatus[i] = src.m_resultStatus;
+      penalties[i] = src.m_penalties;
+   }
+}
+
+void F12020CarStateStore::ScatterParticipants(const PacketParticipantsData& packet)
+{
+   for (int i = 0; i < F12020_MAX_CARS; ++i)
+   {
+      teamId[i] = packet.m_participants[i].m_teamId;
+      raceNumber[i] = packet.m_participants[i].m_raceNumber;
+   }
+}
+
+void F12020CarStateStore::ScatterTelemetry(const PacketCarTelemetryData& packet)
+{
+   constexpr size_t cars = offsetof(PacketCarTelemetryData, m_carTelemetryData);
+   constexpr size_t stride = sizeof(CarTelemetryData);
+   F12020DecodeWheels8To16(tyreInnerTemp, FirstCar(packet, cars, offsetof(CarTelemetryData, m_tyresInnerTemperature)), stride);
+   F12020DecodeWheels8To16(tyreSurfaceTemp, FirstCar(packet, cars, offsetof(CarTelemetryData, m_tyresSurfaceTemperature)), stride);
+   F12020DecodeWheels16(brakeTemp, FirstCar(packet, cars, offsetof(CarTelemetryData, m_brakesTemperature)), stride);
+
+   for (int i = 0; i < F12020_MAX_CARS; ++i)
+      engineTemp[i] = packet.m_carTelemetryData[i].m_engineTemperature;
+}
+
+void F12020CarStateStore::ScatterStatus(const PacketCarStatusData& packet)
+{
+   constexpr size_t cars = offsetof(PacketCarStatusData, m_carStatusData);
+   constexpr size_t stride = sizeof(CarStatusData);
+   F12020DecodeWheels8(tyreWear, FirstCar(packet, cars, offsetof(CarStatusData, m_tyresWear)), stride);
+   F12020DecodeWheels8(tyreDamage, FirstCar(packet, cars, offsetof(CarStatusData, m_tyresDamage)), stride);
+
+   for (int i = 0; i < F12020_MAX_CARS; ++i)
+   {
+      const CarStatusData& src = packet.m_carStatusData[i];
+      frontLeftWingDamage[i] = src.m_frontLeftWingDamage;
+      frontRightWingDamage[i] = src.m_frontRightWingDamage;
+      rearWingDamage[i] = src.m_rearWingDamage;
+      actualTyreCompound[i] = src.m_actualTyreCompound;
+      visualTyreCompound[i] = src.m_visualTyreCompound;
+   }
+}
+
+void F12020CarStateStore::UpdateDamage()
+{
+   for (int i = 0; i < F12020_MAX_CARS; ++i)
+   {
+      float tyres = static_cast<float>(tyreDamage[0][i] + tyreDamage[1][i] + tyreDamage[2][i] + tyreDamage[3][i]);
+      tyres /= 400;
+
+      // map 75% -> 100% ... 0% -> 0%
+      tyreDamageTotal[i] = (tyres >= 0.75f) ? 1.f : tyres * (1.f / 0.75f);
+   }
+
+   for (int i = 0; i < F12020_MAX_CARS; ++i)
+   {
+      float wings = static_cast<float>(frontLeftWingDamage[i] + frontRightWingDamage[i] + rearWingDamage[i]);
+      wings /= 300;
+
+      // map 50% -> 100% ... 0% -> 0%
+      carDamageTotal[i] = (wings >= 0.5f) ? 1.f : wings * (1.f / 0.5f);
+   }
+}
+
+int F12020CarStateStore::FindLeader() const
+{
+   for (int i = 0; i < F12020_MAX_CARS; ++i)
+   {
+      if (position[i] == 1)
+         return i;
+   }
+   return -1;
+}
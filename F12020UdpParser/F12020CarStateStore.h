@@ -0,0 +1,71 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+#include <stdint.h>
+#include "F12020DataDefs.h"
+
+constexpr int F12020_MAX_CARS = 22;
+
+// wheel order of the display, the telemetry uses RL, RR, FL, FR
+enum F12020Wheel
+{
+   F12020_WHEEL_FL,
+   F12020_WHEEL_FR,
+   F12020_WHEEL_RL,
+   F12020_WHEEL_RR,
+   F12020_WHEELS
+};
+
+// Structure of arrays of the per car packet fields used by F12020SessionEngine.
+// The packet decoders scatter each packet into it once, the engine loops then run over
+// contiguous per field arrays instead of the 50-60 byte strided packet structs.
+struct F12020CarStateStore
+{
+   // lap data
+   uint8_t position[F12020_MAX_CARS];
+   uint8_t currentLapNum[F12020_MAX_CARS];
+   uint8_t sector[F12020_MAX_CARS];
+   uint16_t sector1TimeInMS[F12020_MAX_CARS];
+   uint16_t sector2TimeInMS[F12020_MAX_CARS];
+   float lastLapTime[F12020_MAX_CARS];
+   float bestLapTime[F12020_MAX_CARS];
+   uint8_t pitStatus[F12020_MAX_CARS];
+   uint8_t driverStatus[F12020_MAX_CARS];
+   uint8_t resultStatus[F12020_MAX_CARS];
+   uint8_t penalties[F12020_MAX_CARS];
+
+   // participants
+   uint8_t teamId[F12020_MAX_CARS];
+   uint8_t raceNumber[F12020_MAX_CARS];
+
+   // telemetry, [wheel][car] in display order
+   uint16_t tyreInnerTemp[F12020_WHEELS][F12020_MAX_CARS];
+   uint16_t tyreSurfaceTemp[F12020_WHEELS][F12020_MAX_CARS];
+   uint16_t brakeTemp[F12020_WHEELS][F12020_MAX_CARS];
+   uint16_t engineTemp[F12020_MAX_CARS];
+
+   // status, [wheel][car] in display order
+   uint8_t tyreWear[F12020_WHEELS][F12020_MAX_CARS];
+   uint8_t tyreDamage[F12020_WHEELS][F12020_MAX_CARS];
+   uint8_t frontLeftWingDamage[F12020_MAX_CARS];
+   uint8_t frontRightWingDamage[F12020_MAX_CARS];
+   uint8_t rearWingDamage[F12020_MAX_CARS];
+   uint8_t actualTyreCompound[F12020_MAX_CARS];
+   uint8_t visualTyreCompound[F12020_MAX_CARS];
+
+   // derived
+   float tyreDamageTotal[F12020_MAX_CARS]; // 0..1, 75% average tyre damage -> 1
+   float carDamageTotal[F12020_MAX_CARS];  // 0..1, 50% average wing damage -> 1
+
+   void ScatterLap(const PacketLapData& packet);
+   void ScatterParticipants(const PacketParticipantsData& packet);
+   void ScatterTelemetry(const PacketCarTelemetryData& packet);
+   void ScatterStatus(const PacketCarStatusData& packet);
+
+   // recompute the derived damage values of all cars
+   void UpdateDamage();
+
+   // index of the car in P1, -1 if none
+   int FindLeader() const;
+};
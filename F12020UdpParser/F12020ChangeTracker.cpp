@@ -0,0 +1,183 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "F12020ChangeTracker.h"
+
+#include <string.h>
+
+namespace
+{
+   bool operator!=(const F12020LapTimes& a, const F12020LapTimes& b)
+   {
+      return (a.sector1 != b.sector1) || (a.sector2 != b.sector2) || (a.lap != b.lap) || (a.lapsAccumulated != b.lapsAccumulated);
+   }
+}
+
+void F12020ChangeSet::Clear()
+{
+   session = 0;
+   cars = 0;
+   memset(drivers, 0, sizeof(drivers));
+   firstEvent = 0;
+}
+
+void F12020ChangeSet::SetAll()
+{
+   session = F12020_SESSION_ALL;
+   cars = (1u << F12020_MAX_CARS) - 1;
+   for (auto& driver : drivers)
+      driver = F12020_DRIVER_ALL;
+   firstEvent = 0;
+}
+
+void F12020ChangeSet::Merge(const F12020ChangeSet& other)
+{
+   if (other.session & F12020_SESSION_EVENTS)
+      firstEvent = (session & F12020_SESSION_EVENTS) && (firstEvent < other.firstEvent) ? firstEvent : other.firstEvent;
+
+   session |= other.session;
+   cars |= other.cars;
+   for (int i = 0; i < F12020_MAX_CARS; ++i)
+      drivers[i] |= other.drivers[i];
+}
+
+void F12020ChangeTracker::Collect(const F12020EngineSnapshot& snapshot, F12020ChangeSet& changes)
+{
+   changes.Clear();
+
+   if (!m_valid || (snapshot.generation != m_generation))
+   {
+      changes.SetAll();
+      m_valid = true;
+      m_generation = snapshot.generation;
+      m_session = snapshot.session;
+      m_events = snapshot.events;
+      m_classifiedCars = snapshot.classifiedCars;
+      for (int i = 0; i < F12020_MAX_CARS; ++i)
+         m_Read(snapshot, i, m_cars[i]);
+      return;
+   }
+
+   const F12020SessionState& session = snapshot.session;
+   if ((session.track != m_session.track) || (session.sessionType != m_session.sessionType) ||
+      (session.remainingTime != m_session.remainingTime) || (session.totalLaps != m_session.totalLaps))
+      changes.session |= F12020_SESSION_INFO;
+   if (session.sessionFinished != m_session.sessionFinished)
+      changes.session |= F12020_SESSION_FINISHED;
+   if (session.currentLap != m_session.currentLap)
+      changes.session |= F12020_SESSION_CURRENT_LAP;
+   if (session.countDrivers != m_session.countDrivers)
+      changes.session |= F12020_SESSION_COUNT_DRIVERS;
+   m_session = session;
+
+   if (snapshot.events != m_events)
+   {
+      changes.session |= F12020_SESSION_EVENTS;
+      changes.firstEvent = m_events;
+      m_events = snapshot.events;
+   }
+
+   if (snapshot.classifiedCars != m_classifiedCars)
+   {
+      changes.session |= F12020_SESSION_CLASSIFICATION;
+      m_classifiedCars = snapshot.classifiedCars;
+   }
+
+   for (int i = 0; i < F12020_MAX_CARS; ++i)
+   {
+      Car car;
+      m_Read(snapshot, i, car);
+      const uint32_t dirty = m_Compare(m_cars[i], car);
+      if (!dirty)
+         continue;
+
+      changes.drivers[i] = dirty;
+      changes.cars |= 1u << i;
+      m_cars[i] = car;
+   }
+}
+
+void F12020ChangeTracker::m_Read(const F12020EngineSnapshot& snapshot, int i, Car& car)
+{
+   const F12020DriverState& native = snapshot.drivers[i];
+   const F12020CarStateStore& cars = snapshot.cars;
+
+   car.present = native.present;
+   car.isPlayer = native.isPlayer;
+   car.status = native.status;
+   car.team = native.team;
+   car.tyre = native.tyre;
+   car.visualTyre = native.visualTyre;
+   car.raceNumber = cars.raceNumber[i];
+   car.teamId = cars.teamId[i];
+   car.pos = native.pos;
+   car.lapNr = native.lapNr;
+   car.tyreAge = native.tyreAge;
+   car.penaltySeconds = native.penaltySeconds;
+   car.fastestLap = native.fastestLap;
+   car.timedeltaToPlayer = native.timedeltaToPlayer;
+   car.lastTimedeltaToPlayer = native.lastTimedeltaToPlayer;
+   car.timedeltaToLeader = native.timedeltaToLeader;
+   car.tyreDamage = cars.tyreDamageTotal[i];
+   car.carDamage = cars.carDamageTotal[i];
+   car.numVisualTyres = native.numVisualTyres;
+   car.numPitPenalties = native.numPitPenalties;
+   car.currentLap = snapshot.Lap(i, native.lapNr);
+   car.previousLap = snapshot.Lap(i, native.lapNr - 1);
+
+   car.servedPitPenalties = snapshot.servedPitPenalties[i];
+
+   for (int w = 0; w < F12020_WHEELS; ++w)
+   {
+      car.temps[0][w] = cars.tyreInnerTemp[w][i];
+      car.temps[1][w] = cars.tyreSurfaceTemp[w][i];
+      car.temps[2][w] = cars.brakeTemp[w][i];
+      car.tyreWear[w] = cars.tyreWear[w][i];
+   }
+   car.engineTemp = cars.engineTemp[i];
+   car.wingDamage[0] = cars.frontLeftWingDamage[i];
+   car.wingDamage[1] = cars.frontRightWingDamage[i];
+}
+
+uint32_t F12020ChangeTracker::m_Compare(const Car& a, const Car& b)
+{
+   uint32_t dirty = 0;
+   if (a.present != b.present)
+      dirty |= F12020_DRIVER_PRESENT;
+   if (a.isPlayer != b.isPlayer)
+      dirty |= F12020_DRIVER_PLAYER;
+   if (a.status != b.status)
+      dirty |= F12020_DRIVER_STATUS;
+   if (a.team != b.team)
+      dirty |= F12020_DRIVER_TEAM;
+   if ((a.tyre != b.tyre) || (a.visualTyre != b.visualTyre))
+      dirty |= F12020_DRIVER_TYRE;
+   if (a.pos != b.pos)
+      dirty |= F12020_DRIVER_POS;
+   if (a.lapNr != b.lapNr)
+      dirty |= F12020_DRIVER_LAP_NR;
+   if (a.tyreAge != b.tyreAge)
+      dirty |= F12020_DRIVER_TYRE_AGE;
+   if (a.penaltySeconds != b.penaltySeconds)
+      dirty |= F12020_DRIVER_PENALTY;
+   if (a.fastestLap != b.fastestLap)
+      dirty |= F12020_DRIVER_FASTEST_LAP;
+   if ((a.timedeltaToPlayer != b.timedeltaToPlayer) || (a.lastTimedeltaToPlayer != b.lastTimedeltaToPlayer))
+      dirty |= F12020_DRIVER_DELTA_PLAYER;
+   if (a.timedeltaToLeader != b.timedeltaToLeader)
+      dirty |= F12020_DRIVER_DELTA_LEADER;
+   if ((a.tyreDamage != b.tyreDamage) || (a.carDamage != b.carDamage))
+      dirty |= F12020_DRIVER_DAMAGE;
+   if (memcmp(a.temps, b.temps, sizeof(a.temps)) || (a.engineTemp != b.engineTemp) ||
+      memcmp(a.tyreWear, b.tyreWear, sizeof(a.tyreWear)) || memcmp(a.wingDamage, b.wingDamage, sizeof(a.wingDamage)))
+      dirty |= F12020_DRIVER_DETAIL;
+   if (a.numVisualTyres != b.numVisualTyres)
+      dirty |= F12020_DRIVER_STINTS;
+   if ((a.numPitPenalties != b.numPitPenalties) || (a.servedPitPenalties != b.servedPitPenalties))
+      dirty |= F12020_DRIVER_PIT_PENALTIES;
+   if ((a.currentLap != b.currentLap) || (a.previousLap != b.previousLap))
+      dirty |= F12020_DRIVER_LAPS;
+   if ((a.raceNumber != b.raceNumber) || (a.teamId != b.teamId))
+      dirty |= F12020_DRIVER_PARTICIPANT;
+   return dirty;
+}
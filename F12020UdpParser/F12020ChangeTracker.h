@@ -0,0 +1,114 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+#include <stdint.h>
+#include "F12020StateSnapshot.h"
+
+// Coalesced change sets of the engine state for one consumer. Collect() compares the projected state of a snapshot with
+// the state of its previous call, so any number of packets and frames in between result in one set of dirty bits per car
+// and for the session. A consumer projects only the dirty groups instead of the complete state on every tick.
+
+// groups of F12020DriverState / F12020CarStateStore fields, values match adjsw::F12020::DriverFields
+enum F12020DriverField : uint32_t
+{
+   F12020_DRIVER_PRESENT = 1u << 0,
+   F12020_DRIVER_PLAYER = 1u << 1,
+   F12020_DRIVER_STATUS = 1u << 2,
+   F12020_DRIVER_TEAM = 1u << 3,
+   F12020_DRIVER_TYRE = 1u << 4,           // actual and visual compound
+   F12020_DRIVER_POS = 1u << 5,
+   F12020_DRIVER_LAP_NR = 1u << 6,
+   F12020_DRIVER_TYRE_AGE = 1u << 7,
+   F12020_DRIVER_PENALTY = 1u << 8,        // time penalties
+   F12020_DRIVER_FASTEST_LAP = 1u << 9,
+   F12020_DRIVER_DELTA_PLAYER = 1u << 10,  // current and last delta
+   F12020_DRIVER_DELTA_LEADER = 1u << 11,
+   F12020_DRIVER_DAMAGE = 1u << 12,        // total tyre and car damage
+   F12020_DRIVER_DETAIL = 1u << 13,        // wear, temperatures and wing damage
+   F12020_DRIVER_STINTS = 1u << 14,        // visual tyre history
+   F12020_DRIVER_PIT_PENALTIES = 1u << 15, // issued or served
+   F12020_DRIVER_LAPS = 1u << 16,          // times of the current or the previous lap
+   F12020_DRIVER_PARTICIPANT = 1u << 17,   // race number and team of the participants packet
+   F12020_DRIVER_ALL = (1u << 18) - 1
+};
+
+// values match adjsw::F12020::SessionFields
+enum F12020SessionField : uint32_t
+{
+   F12020_SESSION_INFO = 1u << 0,          // track, session type, remaining time, total laps
+   F12020_SESSION_FINISHED = 1u << 1,
+   F12020_SESSION_CURRENT_LAP = 1u << 2,
+   F12020_SESSION_COUNT_DRIVERS = 1u << 3,
+   F12020_SESSION_EVENTS = 1u << 4,        // new events from F12020ChangeSet::firstEvent on
+   F12020_SESSION_CLASSIFICATION = 1u << 5,
+   F12020_SESSION_NEW = 1u << 6,           // the engine was cleared, everything else is set as well
+   F12020_SESSION_ALL = (1u << 7) - 1
+};
+
+struct F12020ChangeSet
+{
+   uint32_t session;                  // F12020SessionField bits
+   uint32_t cars;                     // bit i is set if drivers[i] is not 0
+   uint32_t drivers[F12020_MAX_CARS]; // F12020DriverField bits
+   uint32_t firstEvent;               // index into F12020SessionEngine::events, see F12020SnapshotHistory::Event
+
+   bool Empty() const { return !session && !cars; }
+   void Clear();
+   void SetAll();
+   void Merge(const F12020ChangeSet& other); // e.g. to accumulate until the consumer picks the changes up
+};
+
+struct F12020ChangeTracker
+{
+   // the changes since the last call, everything on the first call and after a new session
+   void Collect(const F12020EngineSnapshot& snapshot, F12020ChangeSet& changes);
+
+   // the next Collect() reports everything
+   void Reset() { m_valid = false; }
+
+private:
+   // the state of the last Collect(), only what a projection reads
+   struct Car
+   {
+      bool present;
+      bool isPlayer;
+      F12020DriverStatus status;
+      uint8_t team;
+      uint8_t tyre;
+      uint8_t visualTyre;
+      uint8_t raceNumber;
+      uint8_t teamId;
+      int pos;
+      int lapNr;
+      int tyreAge;
+      int penaltySeconds;
+      float fastestLap;
+      float timedeltaToPlayer;
+      float lastTimedeltaToPlayer;
+      float timedeltaToLeader;
+      float tyreDamage;
+      float carDamage;
+      int numVisualTyres;
+      int numPitPenalties;
+      uint32_t servedPitPenalties; // bit j: pitPenalties[j] served
+      F12020LapTimes currentLap;
+      F12020LapTimes previousLap;
+
+      // car detail in display order
+      uint16_t temps[3][F12020_WHEELS]; // inner, surface, brake
+      uint16_t engineTemp;
+      uint8_t tyreWear[F12020_WHEELS];
+      uint8_t wingDamage[2];
+   };
+
+   static void m_Read(const F12020EngineSnapshot& snapshot, int i, Car& car);
+   static uint32_t m_Compare(const Car& a, const Car& b);
+
+   bool m_valid{ false };
+   uint32_t m_generation{ 0 };
+   F12020SessionState m_session{};
+   uint32_t m_events{ 0 };
+   uint8_t m_classifiedCars{ 0 };
+   Car m_cars[F12020_MAX_CARS]{};
+};
@@ -1,497 +1,681 @@
-// Copyright 2018-2021 Andreas Jung
-// SPDX-License-Identifier: GPL-3.0-only
-
-#pragma once
-using namespace System;
-using namespace System::Collections::Generic;
-#include <string.h>
-#include <list>
-
-namespace adjsw::F12020
-{
-   public enum class F1Team : int
-   {
-   Mercedes,
-   Ferrari,
-   RedBull,
-   Williams,
-   ForceIndia,
-   Renault,
-   TorroRosso,
-   Haas,   
-   McLaren,
-   Sauber,
-   Classic
-   };
-
-   // F1 2020:
-   // Modern - 16 = C5, 17 = C4, 18 = C3, 19 = C2, 20 = C1
-   // 7 = inter, 8 = wet
-   // F1 Classic - 9 = dry, 10 = wet
-   // F2  11 = super soft, 12 = soft, 13 = medium, 14 = hard
-   // 15 = wet
-
-   public enum class F1Tyre : int
-   {
-      // F1 Modern - 16 = C5, 17 = C4, 18 = C3, 19 = C2, 20 = C1
-      // 7 = inter, 8 = wet
-      // F1 Classic - 9 = dry, 10 = wet
-      // F2  11 = super soft, 12 = soft, 13 = medium, 14 = hard
-      // 15 = wet
-
-      Intermediate = 7,
-      Wet = 8,
-
-      C5 = 16,
-      C4 = 17,
-      C3 = 18,
-      C2 = 19,
-      C1 = 20,
-
-      ClassicDry = 9,
-      ClassicWet = 10,
-
-      F2SuperSoft = 11,
-      F2Soft = 12,
-      F2Medium = 13,
-      F2Hard = 14,
-      F2Wet = 15,
-
-      Other,
-   };
-
-   public enum class F1VisualTyre : int
-   {
-      // F1 visual (can be different from actual compound)
-      // 16 = soft, 17 = medium, 18 = hard, 7 = inter, 8 = wet
-      // F1 Classic  same as above
-      // F2  same as above
-
-      Intermediate = 7,
-      Wet = 8,
-
-      Soft = 16,
-      Medium = 17,
-      Hard = 18
-   };
-
-   public enum class Track
-   {
-      Unknown = -1,
-      Melbourne = 0,
-      PaulRicard,
-      Shanghai,
-      Sakhir,
-      Catalunya,
-      Monaco,
-      Montreal,
-      Silverstone,
-      Hockenheim,
-      Hungaroring,
-      Spa,
-      Monza,
-      Singapore,
-      Suzuka,
-      AbuDhabi,
-      Texas,
-      Brazil,
-      Austria,
-      Sochi,
-      Mexico,
-      Baku,
-      SakhirShort,
-      SilverstoneShort,
-      TexasShort,
-      SuzukaShort,
-      Hanoi,
-      Zandvoort
-   };
-
-   public enum class SessionType
-   {
-      Unknown = 0,
-      P1,
-      P2,
-      P3,
-      ShortPractice,
-      Q1,
-      Q2,
-      Q3,
-      ShortQ,
-      OSQ,
-      Race,
-      Race2,
-      TimeTrial
-   };
-
-   public enum class DriverStatus
-   {
-      Garage,
-      OnTrack,
-      Pitlane,
-      Pitting,
-      DNF,
-      DSQ
-   };
-
-
-   public enum class EventType
-   {
-      SessionStarted,
-      SessionEnded,
-      FastestLap,
-      Retirement,
-      DRSenabled,
-      DRSdisabled,
-      TeamMateInPits,
-      ChequeredFlag,
-      RaceWinner,
-      PenaltyIssued,
-      SpeedTrapTriggered
-   };
-
-   public enum class PenaltyTypes
-   {
-      DriveThrough = 0,
-      StopGo,
-      GridPenalty,
-      PenaltyReminder,
-      TimePenalty,
-      Warning,
-      Disqualified,
-      RemovedFromFormationLap,
-      ParkedTooLongTimer,
-      TyreRegulations,
-      ThisLapInvalidated,
-      ThisAndNextLapInvalidated,
-      ThisLapInvalidatedWithoutReason,
-      ThisAndNextLapInvalidatedWithoutReason,
-      ThisAndPreviousLapInvalidated,
-      ThisAndPreviousLapInvalidatedWithoutReason,
-      Retired,
-      BlackFlagTimer
-   };
-
-   public enum class InfringementTypes
-   {
-      BlockingBySlowDriving = 0,
-      BlockinByWrongWayDriving,
-      ReversingOffTheStartLine,
-      BigCollision,
-      SmallCollision,
-      CollisionFailedToHandBackPositionSingle,
-      CollisionFailedToHandBackPositionMultiple,
-      CornerCuttingGainedTime,
-      CornerCuttingOvertakeSingle,
-      CornerCuttingOvertakeMultiple,
-      CrossedPitExitLane,
-      IgnoringBlueFlags,
-      IgnoringYellowFlags,
-      IgnoringDriveThrough,
-      TooManyDriveThroughs,
-      DriveThroughReminderServeWithinNLaps,
-      DriveThroughReminderServeThisLap,
-      PitLaneSpeeding,
-      ParkedForTooLong,
-      IgnoringTyreRegulations,
-      TooManyPenalties,
-      MultipleWarnings,
-      ApproachingDisqualification,
-      TyreRegulationsSelectSingle,
-      TyreRegulationsSelectMultiple,
-      LapInvalidatedCornerCutting,
-      LapInvalidatedRunningWide,
-      CornerCuttingRanWideGainedTimeMinor,
-      CornerCuttingRanWideGainedTimeSignificant,
-      CornerCuttingRanWideGainedTimeExtreme,
-      LapInvalidatedWallRiding,
-      LapInvalidatedFlashbackUsed,
-      LapInvalidatedResetToTrack,
-      BlockingThePitlane,
-      JumpStart,
-      SafetyCarToCarCollision,
-      SafetyCarIllegalOvertake,
-      SafetyCarExceedingAllowedPace,
-      VirtualSafetyCarExceedingAllowedPace,
-      FormationLapBelowAllowedSpeed,
-      RetiredMechanicalFailure,
-      RetiredTerminallyDamaged,
-      SafetyCarFallingTooFarBack,
-      BlackFlagTimer,
-      UnservedStopGoPenalty,
-      UnservedDriveThroughPenalty,
-      EngineComponentChange,
-      GearboxChange,
-      LeagueGridPenalty,
-      RetryPenalty,
-      IllegalTimeGain,
-      MandatoryPitstop
-   };
-
-
-   public ref class SessionEvent
-   {
-   public:
-      property DateTime TimeCode;
-      property EventType Type;
-      property int CarIndex;
-
-      // penalty info
-      property PenaltyTypes PenaltyType;
-      property InfringementTypes InfringementType;
-      property int OtherVehicleIdx;
-      property int TimeGained; // Time gained, or time spent doing action in seconds
-      property int LapNum;
-      property int PlacesGained;
-      property bool PenaltyServed; // not present in actual telemetry, deduced from race telemetry
-   };
-
-
-   public ref class SessionInfo : public System::ComponentModel::INotifyPropertyChanged
-   {
-   public:      
-      property Track EventTrack { Track get() { return m_track; } void set(Track val) { if (val != m_track) { m_track = val; NPC("EventTrack"); } } };
-
-      property SessionType Session { SessionType get() { return m_session; } void set(SessionType val) { if (val != m_session) { m_session = val; NPC("Session"); } } };
-      property bool SessionFinshed { bool get() { return m_sessionFinished; } void set(bool val) { if (val != m_sessionFinished) { m_sessionFinished = val; NPC("SessionFinshed"); } } };
-
-      // for training / qualifying
-      property int RemainingTime { int get() { return m_remainingSeconds; } void set(int val) { if (val != m_remainingSeconds) { m_remainingSeconds = val; NPC("RemainingTime"); } } };
-
-      // for race
-      property int TotalLaps { int get() { return m_totalLaps; } void set(int val) { if (val != m_totalLaps) { m_totalLaps = val; NPC("TotalLaps"); } } };
-      property int CurrentLap { int get() { return m_currentLap; } void set(int val) { if (val != m_currentLap) { m_currentLap = val; NPC("CurrentLap"); } } };
-
-      void NPC(String^ name) { PropertyChanged(this, gcnew System::ComponentModel::PropertyChangedEventArgs(name)); }
-      virtual event System::ComponentModel::PropertyChangedEventHandler^ PropertyChanged;
-
-   private:
-      Track m_track{ Track::Austria };
-      SessionType m_session{ SessionType::P1 };
-      bool m_sessionFinished{ false };
-      int m_remainingSeconds{ 0 };
-      int m_totalLaps{ 2 };
-      int m_currentLap{ 1 };      
-   };
-
-
-
-   public ref class SessionEventList : public System::ComponentModel::INotifyPropertyChanged
-   {
-   public:
-      SessionEventList()
-      {
-         m_events = gcnew List<SessionEvent^>();
-      }
-
-      property List<SessionEvent^>^ Events {  List<SessionEvent^>^ get() { return m_events; } void set(List<SessionEvent^>^ val) { m_events = val; NPC("Events"); } };
-
-      void NPC(String^ name) { PropertyChanged(this, gcnew System::ComponentModel::PropertyChangedEventArgs(name)); }
-      virtual event System::ComponentModel::PropertyChangedEventHandler^ PropertyChanged;
-
-   private:
-      List<SessionEvent^>^ m_events;
-   };
-
-   public ref class LapData
-   {
-   public:
-      property float Sector1;
-      property float Sector2;
-      property float Lap;
-      property float LapsAccumulated;
-      property List<SessionEvent^>^ Incidents;
-   };
-
-   public ref class CarDetail
-   {
-   public:
-      property int DamageFrontLeft {int get() { return m_dmgFrontLeft; } void set(int val) { m_dmgFrontLeft = val; } };
-      property int DamageFrontRight {int get() { return m_dmgFrontRight; } void set(int val) { m_dmgFrontRight = val; } };
-
-      property int WearFrontLeft {int get() { return m_wearFrontLeft; } void set(int val) { m_wearFrontLeft = val; } };      
-      property int WearFrontRight {int get() { return m_wearFrontRight; } void set(int val) { m_wearFrontRight = val; } };
-      property int WearRearLeft {int get() { return m_wearRearLeft; } void set(int val) { m_wearRearLeft = val; } };
-      property int WearRearRight {int get() { return m_wearRearRight; } void set(int val) { m_wearRearRight = val; } };
-
-      property int TempFrontLeftInner {int get() { return m_tempFrontLeftInner; } void set(int val) { m_tempFrontLeftInner = val; } };
-      property int TempFrontLeftOuter {int get() { return m_tempFrontLeftOuter; } void set(int val) { m_tempFrontLeftOuter = val; } };
-      property int TempFrontRightInner {int get() { return m_tempFrontRightInner; } void set(int val) { m_tempFrontRightInner = val; } };
-      property int TempFrontRightOuter {int get() { return m_tempFrontRightOuter; } void set(int val) { m_tempFrontRightOuter = val; } };
-
-      property int TempRearLeftInner {int get() { return m_tempRearLeftInner; } void set(int val) { m_tempRearLeftInner = val; } };
-      property int TempRearLeftOuter {int get() { return m_tempRearLeftOuter; } void set(int val) { m_tempRearLeftOuter = val; } };
-      property int TempRearRightInner {int get() { return m_tempRearRightInner; } void set(int val) { m_tempRearRightInner = val; } };
-      property int TempRearRightOuter {int get() { return m_tempRearRightOuter; } void set(int val) { m_tempRearRightOuter = val; } };
-
-      property int TempEngine {int get() { return m_tempEngine; } void set(int val) { m_tempEngine = val; } };
-
-      property int TempBrakeFrontLeft {int get() { return m_tempBrakeFrontLeft; } void set(int val) { m_tempBrakeFrontLeft = val; } };
-      property int TempBrakeFrontRight {int get() { return m_tempBrakeFrontRight; } void set(int val) { m_tempBrakeFrontRight = val; } };
-
-      property int TempBrakeRearLeft{int get() { return m_tempBrakeRearLeft; } void set(int val) { m_tempBrakeRearLeft = val; } };
-      property int TempBrakeRearRight {int get() { return m_tempBrakeRearRight; } void set(int val) { m_tempBrakeRearRight = val; } };
-
-   private:
-      int m_dmgFrontLeft{ 0 };
-      int m_dmgFrontRight{ 0 };
-      int m_wearFrontLeft{ 0 };
-      int m_wearFrontRight{ 0 };
-      int m_wearRearLeft{ 0 };
-      int m_wearRearRight{ 0 };     
-
-      int m_tempFrontLeftInner{ 0 };
-      int m_tempFrontLeftOuter{ 0 };
-      int m_tempFrontRightInner{ 0 };
-      int m_tempFrontRightOuter{ 0 };
-
-      int m_tempRearLeftInner{ 0 };
-      int m_tempRearLeftOuter{ 0 };
-      int m_tempRearRightInner{ 0 };
-      int m_tempRearRightOuter{ 0 };
-
-      int m_tempEngine{0};
-      int m_tempBrakeFrontLeft{ 0 };
-      int m_tempBrakeFrontRight{ 0 };
-      int m_tempBrakeRearLeft{ 0 };
-      int m_tempBrakeRearRight{ 0 };
-   };
-
-   public ref class DriverData : public System::ComponentModel::INotifyPropertyChanged
-   {
-   public:
-      DriverData()
-      {
-         m_driverNameNative = new char[48];
-         Reset();
-         m_carDetail = gcnew CarDetail;
-      }
-      ~DriverData() { delete m_driverNameNative; }
-
-      void Reset()
-      {
-         Name = "";
-         TelemetryName = "";
-         MappedName = "";
-         m_driverNameNative[0] = 0;
-         Pos = 0;
-         LapNr = 1;
-         Laps = gcnew array<LapData^>(100); // 100 Laps ought to be enough for anybody
-         for (int i = 0; i < Laps->Length; ++i)
-         {
-            Laps[i] = gcnew LapData();
-            Laps[i]->Incidents = gcnew List<SessionEvent^>();
-         }
-         FastestLap = gcnew LapData();           
-
-         IsPlayer = false;
-         Present = false;
-         VisualTyres = gcnew List<F1VisualTyre>();
-         PitPenalties = gcnew List<SessionEvent^>();
-         m_lapTiresFitted = 1;
-         m_hasPitted = false;
-      }
-
-      void SetNameFromTelemetry(const char(&pName)[48])
-      {
-         if (strcmp(pName, m_driverNameNative))
-         {
-            strncpy_s(m_driverNameNative,48, pName, 48);
-            unsigned sz = strlen(m_driverNameNative);
-            array<Byte>^ arr = gcnew array<Byte>(sz);
-            for (unsigned i = 0; i < sz; ++i)
-               arr[i] = m_driverNameNative[i];
-
-            TelemetryName = System::Text::Encoding::UTF8->GetString(arr);
-         }
-      }
-
-      property String^ Name {String^ get() { return m_name; } void set(String^ val) { if (!String::Equals(val, m_name)) { m_name = val; NPC("Name"); } } }; // The name for Display
-      property String^ TelemetryName {String^ get() { return m_telemetryName; } void set(String^ val) { if (!String::Equals(val, m_telemetryName)) { m_telemetryName = val; NPC("TelemetryName"); } } }; // The name from telemetry
-      property String^ MappedName {String^ get() { return m_mappedName; } void set(String^ val) { if (!String::Equals(val, m_mappedName)) { m_mappedName = val; NPC("MappedName"); } } }; // The name from translation mappings
-      property bool IsPlayer {bool get() { return m_isPlayer; } void set(bool val) { if (val != m_isPlayer) { m_isPlayer = val; NPC("IsPlayer"); } } };
-      property bool Present {bool get() { return m_present; } void set(bool val) { if (val != m_present) { m_present = val; NPC("Present"); } } };
-      property DriverStatus Status {DriverStatus get() { return m_status; } void set(DriverStatus val) { if (val != m_status) { m_status = val; NPC("Status"); } } };
-      property F1Team Team {F1Team get() { return m_team; } void set(F1Team val) { if (val != m_team) { m_team = val; NPC("Team"); } } };
-      property F1Tyre Tyre {F1Tyre get() { return m_tyre; } void set(F1Tyre val) { if (val != m_tyre) { m_tyre = val; NPC("Tyre"); } } };
-      property F1VisualTyre VisualTyre {F1VisualTyre get() { return m_visualTyre; } void set(F1VisualTyre val) { if (val != m_visualTyre) { m_visualTyre = val; NPC("VisualTyre"); } } };
-      property List<F1VisualTyre>^ VisualTyres {List<F1VisualTyre>^ get() { return m_visualTyres; } void set(List<F1VisualTyre>^ val) { m_visualTyres = val; NPC("VisualTyres"); } };
-      property List<SessionEvent^>^ PitPenalties {List<SessionEvent^>^ get() { return m_otherPenalties; } void set(List<SessionEvent^>^ val) { m_otherPenalties = val; NPC("PitPenalties"); } };
-      property int TyreAge {int get() { return m_tyreAge; } void set(int val) { if (val != m_tyreAge) { m_tyreAge = val; NPC("TyreAge"); } } };
-      property float TyreDamage {float get() { return m_tyreDamage; } void set(float val) { if (val != m_tyreDamage) { m_tyreDamage = val; NPC("TyreDamage"); } } };
-      property int Pos {int get() { return m_pos; } void set(int val) { if (val != m_pos) { m_pos = val; NPC("Pos"); } } };
-      property int LapNr {int get() { return m_lapNr; } void set(int val) { if (val != m_lapNr) { m_lapNr = val; NPC("LapNr"); } } };
-      property array<LapData^>^ Laps {array<LapData^>^ get() { return m_laps; } void set(array<LapData^>^ val) { m_laps = val; /*NPC("Laps");*/ }};
-      property LapData^ FastestLap {LapData^ get() { return m_fastestLap; } void set(LapData^ val) { m_fastestLap = val; NPC("FastestLap"); }};
-      property int PenaltySeconds {int get() { return m_penaltySeconds; } void set(int val) { if (val != m_penaltySeconds) { m_penaltySeconds = val; NPC("PenaltySeconds"); } } };
-      property float TimedeltaToPlayer {float get() { return m_timedeltaToPlayer; } void set(float val) { if (val != m_timedeltaToPlayer) { m_timedeltaToPlayer = val; NPC("TimedeltaToPlayer"); } } };
-      property float LastTimedeltaToPlayer {float get() { return m_lastTimedeltaToPlayer; } void set(float val) { if (val != m_lastTimedeltaToPlayer) { m_lastTimedeltaToPlayer = val; NPC("LastTimedeltaToPlayer"); } } };
-      property float TimedeltaToLeader {float get() { return m_timedeltaToLeader; } void set(float val) { if (val != m_timedeltaToLeader) { m_timedeltaToLeader = val; NPC("TimedeltaToLeader"); } } };
-      property float CarDamage {float get() { return m_carDamage; } void set(float val) { if (val != m_carDamage) { m_carDamage = val; NPC("CarDamage"); } } };
-
-      property CarDetail^ WearDetail {CarDetail^ get() { return m_carDetail; } void set(CarDetail^ val) { m_carDetail = val; } };
-
-      void NPC(String^ name) { PropertyChanged(this, gcnew System::ComponentModel::PropertyChangedEventArgs(name)); }
-      virtual event System::ComponentModel::PropertyChangedEventHandler^ PropertyChanged;
-
-   private:
-      
-      char* m_driverNameNative = nullptr;
-
-      String^ m_name;
-      String^ m_telemetryName;
-      String^ m_mappedName;
-      DriverStatus m_status;
-      bool m_isPlayer;
-      bool m_present;
-      F1Team m_team;
-      F1Tyre m_tyre;
-      F1VisualTyre m_visualTyre;
-      List<F1VisualTyre>^ m_visualTyres;
-      List<SessionEvent^>^ m_otherPenalties; // all penalties except time penalties, which cant be served in the pits
-      int m_tyreAge;
-      float m_tyreDamage; // TODO Remove, not included for Online Mutiplayer when telemetry = basic
-      int m_pos;
-      int m_lapNr;
-      int m_penaltySeconds;      
-      float m_carDamage;
-      array<LapData^>^ m_laps;
-      LapData^ m_fastestLap;
-      float m_timedeltaToPlayer;
-      float m_lastTimedeltaToPlayer;
-      float m_timedeltaToLeader;
-      CarDetail^ m_carDetail;
-      int m_lapTiresFitted{ 1 }; // for tyre age, which is not directly available in non complete telemetry.
-      int m_hasPitted{ 0 }; // for tyre age, which is not directly available in non complete telemetry.
-   };
-
-   public ref class ClassificationData
-   {
-   public:
-      property DriverData^ Driver;
-      property int Position;        // Finishing position
-      property int NumLaps;         // Number of laps completed
-      property int GridPosition;    // Grid position of the car
-      property int Points;          // Number of points scored
-      property float BestLapTime;   // Best lap time of the session in seconds
-      property double TotalRaceTime;// Total race time in seconds without penalties
-      property int PenaltiesTime;   // Total penalties accumulated in seconds
-      property int NumPenalties;    // Number of penalties applied to this driver
-   };
-
-   public ref class DriverNameMapping
-   {
-   public:
-      property String^ Name;
-      property Nullable<F1Team> Team;
-      property int DriverNumber;
-   };
-
-   public ref class DriverNameMappings
-   {
-   public:
-      property String^ LeagueName; // the name of the mapping set
-      property array<DriverNameMapping^>^ Mappings; // each driver name mapping
-   };
-
-}
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+using namespace System;
+using namespace System::Collections::Generic;
+#include <string.h>
+#include <list>
+#include "F12020DriverNameIndex.h"
+
+namespace adjsw::F12020
+{
+   public enum class F1Team : int
+   {
+   Mercedes,
+   Ferrari,
+   RedBull,
+   Williams,
+   ForceIndia,
+   Renault,
+   TorroRosso,
+   Haas,   
+   McLaren,
+   Sauber,
+   Classic
+   };
+
+   // F1 2020:
+   // Modern - 16 = C5, 17 = C4, 18 = C3, 19 = C2, 20 = C1
+   // 7 = inter, 8 = wet
+   // F1 Classic - 9 = dry, 10 = wet
+   // F2 – 11 = super soft, 12 = soft, 13 = medium, 14 = hard
+   // 15 = wet
+
+   public enum class F1Tyre : int
+   {
+      // F1 Modern - 16 = C5, 17 = C4, 18 = C3, 19 = C2, 20 = C1
+      // 7 = inter, 8 = wet
+      // F1 Classic - 9 = dry, 10 = wet
+      // F2 – 11 = super soft, 12 = soft, 13 = medium, 14 = hard
+      // 15 = wet
+
+      Intermediate = 7,
+      Wet = 8,
+
+      C5 = 16,
+      C4 = 17,
+      C3 = 18,
+      C2 = 19,
+      C1 = 20,
+
+      ClassicDry = 9,
+      ClassicWet = 10,
+
+      F2SuperSoft = 11,
+      F2Soft = 12,
+      F2Medium = 13,
+      F2Hard = 14,
+      F2Wet = 15,
+
+      Other,
+   };
+
+   public enum class F1VisualTyre : int
+   {
+      // F1 visual (can be different from actual compound)
+      // 16 = soft, 17 = medium, 18 = hard, 7 = inter, 8 = wet
+      // F1 Classic – same as above
+      // F2 – same as above
+
+      Intermediate = 7,
+      Wet = 8,
+
+      Soft = 16,
+      Medium = 17,
+      Hard = 18
+   };
+
+   public enum class Track
+   {
+      Unknown = -1,
+      Melbourne = 0,
+      PaulRicard,
+      Shanghai,
+      Sakhir,
+      Catalunya,
+      Monaco,
+      Montreal,
+      Silverstone,
+      Hockenheim,
+      Hungaroring,
+      Spa,
+      Monza,
+      Singapore,
+      Suzuka,
+      AbuDhabi,
+      Texas,
+      Brazil,
+      Austria,
+      Sochi,
+      Mexico,
+      Baku,
+      SakhirShort,
+      SilverstoneShort,
+      TexasShort,
+      SuzukaShort,
+      Hanoi,
+      Zandvoort
+   };
+
+   public enum class SessionType
+   {
+      Unknown = 0,
+      P1,
+      P2,
+      P3,
+      ShortPractice,
+      Q1,
+      Q2,
+      Q3,
+      ShortQ,
+      OSQ,
+      Race,
+      Race2,
+      TimeTrial
+   };
+
+   public enum class DriverStatus
+   {
+      Garage,
+      OnTrack,
+      Pitlane,
+      Pitting,
+      DNF,
+      DSQ
+   };
+
+
+   public enum class EventType
+   {
+      SessionStarted,
+      SessionEnded,
+      FastestLap,
+      Retirement,
+      DRSenabled,
+      DRSdisabled,
+      TeamMateInPits,
+      ChequeredFlag,
+      RaceWinner,
+      PenaltyIssued,
+      SpeedTrapTriggered
+   };
+
+   public enum class PenaltyTypes
+   {
+      DriveThrough = 0,
+      StopGo,
+      GridPenalty,
+      PenaltyReminder,
+      TimePenalty,
+      Warning,
+      Disqualified,
+      RemovedFromFormationLap,
+      ParkedTooLongTimer,
+      TyreRegulations,
+      ThisLapInvalidated,
+      ThisAndNextLapInvalidated,
+      ThisLapInvalidatedWithoutReason,
+      ThisAndNextLapInvalidatedWithoutReason,
+      ThisAndPreviousLapInvalidated,
+      ThisAndPreviousLapInvalidatedWithoutReason,
+      Retired,
+      BlackFlagTimer
+   };
+
+   public enum class InfringementTypes
+   {
+      BlockingBySlowDriving = 0,
+      BlockinByWrongWayDriving,
+      ReversingOffTheStartLine,
+      BigCollision,
+      SmallCollision,
+      CollisionFailedToHandBackPositionSingle,
+      CollisionFailedToHandBackPositionMultiple,
+      CornerCuttingGainedTime,
+      CornerCuttingOvertakeSingle,
+      CornerCuttingOvertakeMultiple,
+      CrossedPitExitLane,
+      IgnoringBlueFlags,
+      IgnoringYellowFlags,
+      IgnoringDriveThrough,
+      TooManyDriveThroughs,
+      DriveThroughReminderServeWithinNLaps,
+      DriveThroughReminderServeThisLap,
+      PitLaneSpeeding,
+      ParkedForTooLong,
+      IgnoringTyreRegulations,
+      TooManyPenalties,
+      MultipleWarnings,
+      ApproachingDisqualification,
+      TyreRegulationsSelectSingle,
+      TyreRegulationsSelectMultiple,
+      LapInvalidatedCornerCutting,
+      LapInvalidatedRunningWide,
+      CornerCuttingRanWideGainedTimeMinor,
+      CornerCuttingRanWideGainedTimeSignificant,
+      CornerCuttingRanWideGainedTimeExtreme,
+      LapInvalidatedWallRiding,
+      LapInvalidatedFlashbackUsed,
+      LapInvalidatedResetToTrack,
+      BlockingThePitlane,
+      JumpStart,
+      SafetyCarToCarCollision,
+      SafetyCarIllegalOvertake,
+      SafetyCarExceedingAllowedPace,
+      VirtualSafetyCarExceedingAllowedPace,
+      FormationLapBelowAllowedSpeed,
+      RetiredMechanicalFailure,
+      RetiredTerminallyDamaged,
+      SafetyCarFallingTooFarBack,
+      BlackFlagTimer,
+      UnservedStopGoPenalty,
+      UnservedDriveThroughPenalty,
+      EngineComponentChange,
+      GearboxChange,
+      LeagueGridPenalty,
+      RetryPenalty,
+      IllegalTimeGain,
+      MandatoryPitstop
+   };
+
+
+   public ref class SessionEvent
+   {
+   public:
+      property DateTime TimeCode;
+      property EventType Type;
+      property int CarIndex;
+
+      // penalty info
+      property PenaltyTypes PenaltyType;
+      property InfringementTypes InfringementType;
+      property int OtherVehicleIdx;
+      property int TimeGained; // Time gained, or time spent doing action in seconds
+      property int LapNum;
+      property int PlacesGained;
+      property bool PenaltyServed; // not present in actual telemetry, deduced from race telemetry
+
+      property float LapTime; // FastestLap: lap time in seconds
+      property float Speed;   // SpeedTrapTriggered: top speed in km/h
+   };
+
+
+   public ref class SessionInfo : public System::ComponentModel::INotifyPropertyChanged
+   {
+   public:      
+      property Track EventTrack { Track get() { return m_track; } void set(Track val) { if (val != m_track) { m_track = val; NPC(s_eventTrackArgs); } } };
+
+      property SessionType Session { SessionType get() { return m_session; } void set(SessionType val) { if (val != m_session) { m_session = val; NPC(s_sessionArgs); } } };
+      property bool SessionFinshed { bool get() { return m_sessionFinished; } void set(bool val) { if (val != m_sessionFinished) { m_sessionFinished = val; NPC(s_sessionFinshedArgs); } } };
+
+      // for training / qualifying
+      property int RemainingTime { int get() { return m_remainingSeconds; } void set(int val) { if (val != m_remainingSeconds) { m_remainingSeconds = val; NPC(s_remainingTimeArgs); } } };
+
+      // for race
+      property int TotalLaps { int get() { return m_totalLaps; } void set(int val) { if (val != m_totalLaps) { m_totalLaps = val; NPC(s_totalLapsArgs); } } };
+      property int CurrentLap { int get() { return m_currentLap; } void set(int val) { if (val != m_currentLap) { m_currentLap = val; NPC(s_currentLapArgs); } } };
+
+      void NPC(String^ name) { PropertyChanged(this, gcnew System::ComponentModel::PropertyChangedEventArgs(name)); }
+      void NPC(System::ComponentModel::PropertyChangedEventArgs^ args) { PropertyChanged(this, args); }
+      virtual event System::ComponentModel::PropertyChangedEventHandler^ PropertyChanged;
+
+   internal:
+      // PropertyChangedEventArgs are immutable, one cached instance per property is shared by all objects
+      static initonly System::ComponentModel::PropertyChangedEventArgs^ s_eventTrackArgs = gcnew System::ComponentModel::PropertyChangedEventArgs("EventTrack");
+      static initonly System::ComponentModel::PropertyChangedEventArgs^ s_sessionArgs = gcnew System::ComponentModel::PropertyChangedEventArgs("Session");
+      static initonly System::ComponentModel::PropertyChangedEventArgs^ s_sessionFinshedArgs = gcnew System::ComponentModel::PropertyChangedEventArgs("SessionFinshed");
+      static initonly System::ComponentModel::PropertyChangedEventArgs^ s_remainingTimeArgs = gcnew System::ComponentModel::PropertyChangedEventArgs("RemainingTime");
+      static initonly System::ComponentModel::PropertyChangedEventArgs^ s_totalLapsArgs = gcnew System::ComponentModel::PropertyChangedEventArgs("TotalLaps");
+      static initonly System::ComponentModel::PropertyChangedEventArgs^ s_currentLapArgs = gcnew System::ComponentModel::PropertyChangedEventArgs("CurrentLap");
+
+   private:
+      Track m_track{ Track::Austria };
+      SessionType m_session{ SessionType::P1 };
+      bool m_sessionFinished{ false };
+      int m_remainingSeconds{ 0 };
+      int m_totalLaps{ 2 };
+      int m_currentLap{ 1 };      
+   };
+
+
+
+   public ref class SessionEventList : public System::ComponentModel::INotifyPropertyChanged
+   {
+   public:
+      SessionEventList()
+      {
+         m_events = gcnew List<SessionEvent^>();
+      }
+
+      property List<SessionEvent^>^ Events {  List<SessionEvent^>^ get() { return m_events; } void set(List<SessionEvent^>^ val) { m_events = val; NPC(s_eventsArgs); } };
+
+      void NPC(String^ name) { PropertyChanged(this, gcnew System::ComponentModel::PropertyChangedEventArgs(name)); }
+      void NPC(System::ComponentModel::PropertyChangedEventArgs^ args) { PropertyChanged(this, args); }
+      virtual event System::ComponentModel::PropertyChangedEventHandler^ PropertyChanged;
+
+   internal:
+      // cached event args, see SessionInfo
+      static initonly System::ComponentModel::PropertyChangedEventArgs^ s_eventsArgs = gcnew System::ComponentModel::PropertyChangedEventArgs("Events");
+
+   private:
+      List<SessionEvent^>^ m_events;
+   };
+
+   public ref class LapData
+   {
+   public:
+      LapData() { Incidents = gcnew List<SessionEvent^>(); }
+
+      property float Sector1;
+      property float Sector2;
+      property float Lap;
+      property float LapsAccumulated;
+      property List<SessionEvent^>^ Incidents;
+   };
+
+   public ref class CarDetail
+   {
+   public:
+      property int DamageFrontLeft {int get() { return m_dmgFrontLeft; } void set(int val) { m_dmgFrontLeft = val; } };
+      property int DamageFrontRight {int get() { return m_dmgFrontRight; } void set(int val) { m_dmgFrontRight = val; } };
+
+      property int WearFrontLeft {int get() { return m_wearFrontLeft; } void set(int val) { m_wearFrontLeft = val; } };      
+      property int WearFrontRight {int get() { return m_wearFrontRight; } void set(int val) { m_wearFrontRight = val; } };
+      property int WearRearLeft {int get() { return m_wearRearLeft; } void set(int val) { m_wearRearLeft = val; } };
+      property int WearRearRight {int get() { return m_wearRearRight; } void set(int val) { m_wearRearRight = val; } };
+
+      property int TempFrontLeftInner {int get() { return m_tempFrontLeftInner; } void set(int val) { m_tempFrontLeftInner = val; } };
+      property int TempFrontLeftOuter {int get() { return m_tempFrontLeftOuter; } void set(int val) { m_tempFrontLeftOuter = val; } };
+      property int TempFrontRightInner {int get() { return m_tempFrontRightInner; } void set(int val) { m_tempFrontRightInner = val; } };
+      property int TempFrontRightOuter {int get() { return m_tempFrontRightOuter; } void set(int val) { m_tempFrontRightOuter = val; } };
+
+      property int TempRearLeftInner {int get() { return m_tempRearLeftInner; } void set(int val) { m_tempRearLeftInner = val; } };
+      property int TempRearLeftOuter {int get() { return m_tempRearLeftOuter; } void set(int val) { m_tempRearLeftOuter = val; } };
+      property int TempRearRightInner {int get() { return m_tempRearRightInner; } void set(int val) { m_tempRearRightInner = val; } };
+      property int TempRearRightOuter {int get() { return m_tempRearRightOuter; } void set(int val) { m_tempRearRightOuter = val; } };
+
+      property int TempEngine {int get() { return m_tempEngine; } void set(int val) { m_tempEngine = val; } };
+
+      property int TempBrakeFrontLeft {int get() { return m_tempBrakeFrontLeft; } void set(int val) { m_tempBrakeFrontLeft = val; } };
+      property int TempBrakeFrontRight {int get() { return m_tempBrakeFrontRight; } void set(int val) { m_tempBrakeFrontRight = val; } };
+
+      property int TempBrakeRearLeft{int get() { return m_tempBrakeRearLeft; } void set(int val) { m_tempBrakeRearLeft = val; } };
+      property int TempBrakeRearRight {int get() { return m_tempBrakeRearRight; } void set(int val) { m_tempBrakeRearRight = val; } };
+
+   private:
+      int m_dmgFrontLeft{ 0 };
+      int m_dmgFrontRight{ 0 };
+      int m_wearFrontLeft{ 0 };
+      int m_wearFrontRight{ 0 };
+      int m_wearRearLeft{ 0 };
+      int m_wearRearRight{ 0 };     
+
+      int m_tempFrontLeftInner{ 0 };
+      int m_tempFrontLeftOuter{ 0 };
+      int m_tempFrontRightInner{ 0 };
+      int m_tempFrontRightOuter{ 0 };
+
+      int m_tempRearLeftInner{ 0 };
+      int m_tempRearLeftOuter{ 0 };
+      int m_tempRearRightInner{ 0 };
+      int m_tempRearRightOuter{ 0 };
+
+      int m_tempEngine{0};
+      int m_tempBrakeFrontLeft{ 0 };
+      int m_tempBrakeFrontRight{ 0 };
+      int m_tempBrakeRearLeft{ 0 };
+      int m_tempBrakeRearRight{ 0 };
+   };
+
+   public ref class DriverData : public System::ComponentModel::INotifyPropertyChanged
+   {
+   public:
+      DriverData()
+      {
+         m_driverNameNative = new char[48];
+         Reset();
+         m_carDetail = gcnew CarDetail;
+      }
+      ~DriverData() { delete m_driverNameNative; }
+
+      void Reset()
+      {
+         Name = "";
+         TelemetryName = "";
+         MappedName = "";
+         m_driverNameNative[0] = 0;
+         Pos = 0;
+         LapNr = 1;
+         Laps = gcnew array<LapData^>(0); // grows with ReserveLaps()
+         FastestLap = gcnew LapData();
+
+         IsPlayer = false;
+         Present = false;
+         VisualTyres = gcnew List<F1VisualTyre>();
+         PitPenalties = gcnew List<SessionEvent^>();
+      }
+
+      // grows Laps in chunks of LAP_CHUNK to hold at least count laps, laps not driven yet cost nothing
+      void ReserveLaps(int count)
+      {
+         if (count <= m_laps->Length)
+            return;
+
+         array<LapData^>^ laps = m_laps;
+         const int first = laps->Length;
+         Array::Resize(laps, ((count + LAP_CHUNK - 1) / LAP_CHUNK) * LAP_CHUNK);
+         for (int i = first; i < laps->Length; ++i)
+            laps[i] = gcnew LapData();
+         m_laps = laps;
+      }
+
+      literal int LAP_CHUNK = 16; // F12020_LAP_CHUNK
+
+      void SetNameFromTelemetry(const char(&pName)[48])
+      {
+         if (strcmp(pName, m_driverNameNative))
+         {
+            strncpy_s(m_driverNameNative,48, pName, 48);
+            unsigned sz = strlen(m_driverNameNative);
+            array<Byte>^ arr = gcnew array<Byte>(sz);
+            for (unsigned i = 0; i < sz; ++i)
+               arr[i] = m_driverNameNative[i];
+
+            TelemetryName = System::Text::Encoding::UTF8->GetString(arr);
+         }
+      }
+
+      property String^ Name {String^ get() { return m_name; } void set(String^ val) { if (!String::Equals(val, m_name)) { m_name = val; NPC(s_nameArgs); } } }; // The name for Display
+      property String^ TelemetryName {String^ get() { return m_telemetryName; } void set(String^ val) { if (!String::Equals(val, m_telemetryName)) { m_telemetryName = val; NPC(s_telemetryNameArgs); } } }; // The name from telemetry
+      property String^ MappedName {String^ get() { return m_mappedName; } void set(String^ val) { if (!String::Equals(val, m_mappedName)) { m_mappedName = val; NPC(s_mappedNameArgs); } } }; // The name from translation mappings
+      property bool IsPlayer {bool get() { return m_isPlayer; } void set(bool val) { if (val != m_isPlayer) { m_isPlayer = val; NPC(s_isPlayerArgs); } } };
+      property bool Present {bool get() { return m_present; } void set(bool val) { if (val != m_present) { m_present = val; NPC(s_presentArgs); } } };
+      property DriverStatus Status {DriverStatus get() { return m_status; } void set(DriverStatus val) { if (val != m_status) { m_status = val; NPC(s_statusArgs); } } };
+      property F1Team Team {F1Team get() { return m_team; } void set(F1Team val) { if (val != m_team) { m_team = val; NPC(s_teamArgs); } } };
+      property F1Tyre Tyre {F1Tyre get() { return m_tyre; } void set(F1Tyre val) { if (val != m_tyre) { m_tyre = val; NPC(s_tyreArgs); } } };
+      property F1VisualTyre VisualTyre {F1VisualTyre get() { return m_visualTyre; } void set(F1VisualTyre val) { if (val != m_visualTyre) { m_visualTyre = val; NPC(s_visualTyreArgs); } } };
+      property List<F1VisualTyre>^ VisualTyres {List<F1VisualTyre>^ get() { return m_visualTyres; } void set(List<F1VisualTyre>^ val) { m_visualTyres = val; NPC(s_visualTyresArgs); } };
+      property List<SessionEvent^>^ PitPenalties {List<SessionEvent^>^ get() { return m_otherPenalties; } void set(List<SessionEvent^>^ val) { m_otherPenalties = val; NPC(s_pitPenaltiesArgs); } };
+      property int TyreAge {int get() { return m_tyreAge; } void set(int val) { if (val != m_tyreAge) { m_tyreAge = val; NPC(s_tyreAgeArgs); } } };
+      property float TyreDamage {float get() { return m_tyreDamage; } void set(float val) { if (val != m_tyreDamage) { m_tyreDamage = val; NPC(s_tyreDamageArgs); } } };
+      property int Pos {int get() { return m_pos; } void set(int val) { if (val != m_pos) { m_pos = val; NPC(s_posArgs); } } };
+      property int LapNr {int get() { return m_lapNr; } void set(int val) { if (val != m_lapNr) { m_lapNr = val; NPC(s_lapNrArgs); } } };
+      property array<LapData^>^ Laps {array<LapData^>^ get() { return m_laps; } void set(array<LapData^>^ val) { m_laps = val; /*NPC("Laps");*/ }};
+      property LapData^ FastestLap {LapData^ get() { return m_fastestLap; } void set(LapData^ val) { m_fastestLap = val; NPC(s_fastestLapArgs); }};
+      property int PenaltySeconds {int get() { return m_penaltySeconds; } void set(int val) { if (val != m_penaltySeconds) { m_penaltySeconds = val; NPC(s_penaltySecondsArgs); } } };
+      property float TimedeltaToPlayer {float get() { return m_timedeltaToPlayer; } void set(float val) { if (val != m_timedeltaToPlayer) { m_timedeltaToPlayer = val; NPC(s_timedeltaToPlayerArgs); } } };
+      property float LastTimedeltaToPlayer {float get() { return m_lastTimedeltaToPlayer; } void set(float val) { if (val != m_lastTimedeltaToPlayer) { m_lastTimedeltaToPlayer = val; NPC(s_lastTimedeltaToPlayerArgs); } } };
+      property float TimedeltaToLeader {float get() { return m_timedeltaToLeader; } void set(float val) { if (val != m_timedeltaToLeader) { m_timedeltaToLeader = val; NPC(s_timedeltaToLeaderArgs); } } };
+      property float CarDamage {float get() { return m_carDamage; } void set(float val) { if (val != m_carDamage) { m_carDamage = val; NPC(s_carDamageArgs); } } };
+
+      property CarDetail^ WearDetail {CarDetail^ get() { return m_carDetail; } void set(CarDetail^ val) { m_carDetail = val; } };
+
+      void NPC(String^ name) { PropertyChanged(this, gcnew System::ComponentModel::PropertyChangedEventArgs(name)); }
+      void NPC(System::ComponentModel::PropertyChangedEventArgs^ args) { PropertyChanged(this, args); }
+      virtual event System::ComponentModel::PropertyChangedEventHandler^ PropertyChanged;
+
+   internal:
+      // cached event args, see SessionInfo
+      static initonly System::ComponentModel::PropertyChangedEventArgs^ s_nameArgs = gcnew System::ComponentModel::PropertyChangedEventArgs("Name");
+      static initonly System::ComponentModel::PropertyChangedEventArgs^ s_telemetryNameArgs = gcnew System::ComponentModel::PropertyChangedEventArgs("TelemetryName");
+      static initonly System::ComponentModel::PropertyChangedEventArgs^ s_mappedNameArgs = gcnew System::ComponentModel::PropertyChangedEventArgs("MappedName");
+      static initonly System::ComponentModel::PropertyChangedEventArgs^ s_isPlayerArgs = gcnew System::ComponentModel::PropertyChangedEventArgs("IsPlayer");
+      static initonly System::ComponentModel::PropertyChangedEventArgs^ s_presentArgs = gcnew System::ComponentModel::PropertyChangedEventArgs("Present");
+      static initonly System::ComponentModel::PropertyChangedEventArgs^ s_statusArgs = gcnew System::ComponentModel::PropertyChangedEventArgs("Status");
+      static initonly System::ComponentModel::PropertyChangedEventArgs^ s_teamArgs = gcnew System::ComponentModel::PropertyChangedEventArgs("Team");
+      static initonly System::ComponentModel::PropertyChangedEventArgs^ s_tyreArgs = gcnew System::ComponentModel::PropertyChangedEventArgs("Tyre");
+      static initonly System::ComponentModel::PropertyChangedEventArgs^ s_visualTyreArgs = gcnew System::ComponentModel::PropertyChangedEventArgs("VisualTyre");
+      static initonly System::ComponentModel::PropertyChangedEventArgs^ s_visualTyresArgs = gcnew System::ComponentModel::PropertyChangedEventArgs("VisualTyres");
+      static initonly System::ComponentModel::PropertyChangedEventArgs^ s_pitPenaltiesArgs = gcnew System::ComponentModel::PropertyChangedEventArgs("PitPenalties");
+      static initonly System::ComponentModel::PropertyChangedEventArgs^ s_tyreAgeArgs = gcnew System::ComponentModel::PropertyChangedEventArgs("TyreAge");
+      static initonly System::ComponentModel::PropertyChangedEventArgs^ s_tyreDamageArgs = gcnew System::ComponentModel::PropertyChangedEventArgs("TyreDamage");
+      static initonly System::ComponentModel::PropertyChangedEventArgs^ s_posArgs = gcnew System::ComponentModel::PropertyChangedEventArgs("Pos");
+      static initonly System::ComponentModel::PropertyChangedEventArgs^ s_lapNrArgs = gcnew System::ComponentModel::PropertyChangedEventArgs("LapNr");
+      static initonly System::ComponentModel::PropertyChangedEventArgs^ s_fastestLapArgs = gcnew System::ComponentModel::PropertyChangedEventArgs("FastestLap");
+      static initonly System::ComponentModel::PropertyChangedEventArgs^ s_penaltySecondsArgs = gcnew System::ComponentModel::PropertyChangedEventArgs("PenaltySeconds");
+      static initonly System::ComponentModel::PropertyChangedEventArgs^ s_timedeltaToPlayerArgs = gcnew System::ComponentModel::PropertyChangedEventArgs("TimedeltaToPlayer");
+      static initonly System::ComponentModel::PropertyChangedEventArgs^ s_lastTimedeltaToPlayerArgs = gcnew System::ComponentModel::PropertyChangedEventArgs("LastTimedeltaToPlayer");
+      static initonly System::ComponentModel::PropertyChangedEventArgs^ s_timedeltaToLeaderArgs = gcnew System::ComponentModel::PropertyChangedEventArgs("TimedeltaToLeader");
+      static initonly System::ComponentModel::PropertyChangedEventArgs^ s_carDamageArgs = gcnew System::ComponentModel::PropertyChangedEventArgs("CarDamage");
+
+   private:
+      
+      char* m_driverNameNative = nullptr;
+
+      String^ m_name;
+      String^ m_telemetryName;
+      String^ m_mappedName;
+      DriverStatus m_status;
+      bool m_isPlayer;
+      bool m_present;
+      F1Team m_team;
+      F1Tyre m_tyre;
+      F1VisualTyre m_visualTyre;
+      List<F1VisualTyre>^ m_visualTyres;
+      List<SessionEvent^>^ m_otherPenalties; // all penalties except time penalties, which can´t be served in the pits
+      int m_tyreAge;
+      float m_tyreDamage; // TODO Remove, not included for Online Mutiplayer when telemetry = basic
+      int m_pos;
+      int m_lapNr;
+      int m_penaltySeconds;      
+      float m_carDamage;
+      array<LapData^>^ m_laps;
+      LapData^ m_fastestLap;
+      float m_timedeltaToPlayer;
+      float m_lastTimedeltaToPlayer;
+      float m_timedeltaToLeader;
+      CarDetail^ m_carDetail;
+   };
+
+   public ref class ClassificationData
+   {
+   public:
+      property DriverData^ Driver;
+      property int Position;        // Finishing position
+      property int NumLaps;         // Number of laps completed
+      property int GridPosition;    // Grid position of the car
+      property int Points;          // Number of points scored
+      property float BestLapTime;   // Best lap time of the session in seconds
+      property double TotalRaceTime;// Total race time in seconds without penalties
+      property int PenaltiesTime;   // Total penalties accumulated in seconds
+      property int NumPenalties;    // Number of penalties applied to this driver
+   };
+
+   public ref class DriverNameMapping
+   {
+   public:
+      property String^ Name;
+      property Nullable<F1Team> Team;
+      property int DriverNumber;
+   };
+
+   public ref class DriverNameMappings
+   {
+   public:
+      property String^ LeagueName; // the name of the mapping set
+      property array<DriverNameMapping^>^ Mappings; // each driver name mapping
+   };
+
+   // DriverNameMappings compiled for O(1) lookups, the tables are F12020DriverNameIndex (shared with the benchmark).
+   // Immutable once built, so a new index replaces the old one with a single reference assignment.
+   public ref class DriverNameIndex
+   {
+   public:
+      DriverNameIndex(DriverNameMappings^ mappings)
+      {
+         m_mappings = mappings;
+         m_index = new F12020DriverNameIndex();
+         if ((mappings == nullptr) || (mappings->Mappings == nullptr))
+            return;
+
+         // the names are copied, later changes of the mappings do not affect the index
+         m_names = gcnew array<String^>(mappings->Mappings->Length);
+         for (int i = 0; i < mappings->Mappings->Length; ++i)
+         {
+            DriverNameMapping^ mapping = mappings->Mappings[i];
+            if ((mapping == nullptr) || (mapping->Name == nullptr))
+               continue; // can not match any car
+
+            m_names[i] = mapping->Name;
+            m_index->Add(i, mapping->Team.HasValue, mapping->Team.HasValue ? static_cast<int>(mapping->Team.Value) : 0, mapping->DriverNumber);
+         }
+      }
+
+      ~DriverNameIndex() { this->!DriverNameIndex(); }
+      !DriverNameIndex() { delete m_index; m_index = nullptr; }
+
+      // the mapped name, a mapping with matching team takes precedence over one without team. nullptr if none matches.
+      String^ Find(F1Team team, int raceNumber)
+      {
+         int position = m_index->Find(static_cast<int>(team), raceNumber);
+         GC::KeepAlive(this); // not finalized while the native tables are read
+         return (position != F12020_NAME_NONE) ? m_names[position] : nullptr;
+      }
+
+      property DriverNameMappings^ Mappings { DriverNameMappings^ get() { return m_mappings; } };
+
+   private:
+      DriverNameMappings^ m_mappings;
+      array<String^>^ m_names; // of the mappings, by position
+      F12020DriverNameIndex* m_index;
+   };
+
+   // changed groups of DriverData properties, values match F12020DriverField (F12020ChangeTracker.h)
+   [System::Flags]
+   public enum class DriverFields : UInt32
+   {
+      None = 0,
+      Present = 1u << 0,
+      IsPlayer = 1u << 1,
+      Status = 1u << 2,
+      Team = 1u << 3,
+      Tyre = 1u << 4,          // Tyre, VisualTyre
+      Pos = 1u << 5,
+      LapNr = 1u << 6,
+      TyreAge = 1u << 7,
+      PenaltySeconds = 1u << 8,
+      FastestLap = 1u << 9,
+      TimedeltaToPlayer = 1u << 10, // TimedeltaToPlayer, LastTimedeltaToPlayer
+      TimedeltaToLeader = 1u << 11,
+      Damage = 1u << 12,       // TyreDamage, CarDamage
+      WearDetail = 1u << 13,
+      VisualTyres = 1u << 14,
+      PitPenalties = 1u << 15,
+      Laps = 1u << 16,
+      Name = 1u << 17,
+      All = (1u << 18) - 1
+   };
+
+   // values match F12020SessionField (F12020ChangeTracker.h)
+   [System::Flags]
+   public enum class SessionFields : UInt32
+   {
+      None = 0,
+      Info = 1u << 0,          // EventTrack, Session, RemainingTime, TotalLaps
+      Finished = 1u << 1,
+      CurrentLap = 1u << 2,
+      CountDrivers = 1u << 3,
+      Events = 1u << 4,
+      Classification = 1u << 5,
+      NewSession = 1u << 6,
+      All = (1u << 7) - 1
+   };
+
+   // coalesced changes since the previous F12020UdpClrMapper::TakeChanges(), the same instance is reused
+   public ref class StateChanges
+   {
+   public:
+      StateChanges() { m_drivers = gcnew array<DriverFields>(22); }
+
+      property SessionFields Session;
+      property UInt32 Cars; // bit i is set if Drivers[i] changed
+      property array<DriverFields>^ Drivers { array<DriverFields>^ get() { return m_drivers; } };
+      property int FirstEvent; // index of the first new event in SessionEventList::Events, if SessionFields::Events is set
+      property bool Empty { bool get() { return (Session == SessionFields::None) && !Cars; } };
+
+      bool Changed(int car, DriverFields fields) { return (m_drivers[car] & fields) != DriverFields::None; }
+
+   private:
+      array<DriverFields>^ m_drivers;
+   };
+
+   // latency histogram of one pipeline stage or packet id, times in microseconds
+   public ref class LatencyStats
+   {
+   public:
+      property String^ Name;
+      property UInt64 Count;
+      property double Mean;
+      property double P50;
+      property double P99;
+      property double Max;
+   };
+
+   // snapshot of the parser instrumentation, see F12020Metrics.h
+   public ref class ParserMetrics
+   {
+   public:
+      property double Seconds; // since the start or the last reset
+      property UInt64 PacketsReceived;
+      property UInt64 PacketsDropped;
+      property UInt64 BytesReceived;
+      property UInt64 PacketsParsed;
+      property UInt64 PacketsInvalid;
+      property UInt64 PacketsSkipped; // not subscribed
+      property int MaxQueueDepth;
+      property array<LatencyStats^>^ Stages;
+      property array<LatencyStats^>^ Packets; // Proceed per packet id
+   };
+
+}
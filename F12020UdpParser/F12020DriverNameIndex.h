@@ -0,0 +1,59 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+#include <stdint.h>
+
+// Driver name mappings compiled for O(1) lookups: direct tables by team + race number and by race number only.
+// The tables hold the position of the mapping in the list, the names stay with the caller
+// (adjsw::F12020::DriverNameIndex in F12020DataDefsClr.h, F12020UdpParserBench).
+// Native and without dependencies, the header is safe for managed code.
+
+constexpr int F12020_NAME_TEAMS = 11;    // F1Team values
+constexpr int F12020_NAME_NUMBERS = 256; // race numbers are 8 bit in the telemetry
+constexpr int32_t F12020_NAME_NONE = -1;
+
+struct F12020DriverNameIndex
+{
+   F12020DriverNameIndex()
+   {
+      for (auto& position : byTeam)
+         position = F12020_NAME_NONE;
+      for (auto& position : byNumber)
+         position = F12020_NAME_NONE;
+   }
+
+   // add the mappings in list order, the first of several matching mappings wins, as with a linear search.
+   // A mapping which can not match any car (team or race number out of range) is ignored.
+   void Add(int32_t position, bool hasTeam, int team, int raceNumber)
+   {
+      if ((raceNumber < 0) || (raceNumber >= F12020_NAME_NUMBERS))
+         return;
+
+      int32_t* slot = &byNumber[raceNumber];
+      if (hasTeam)
+      {
+         if ((team < 0) || (team >= F12020_NAME_TEAMS))
+            return;
+         slot = &byTeam[team * F12020_NAME_NUMBERS + raceNumber];
+      }
+
+      if (*slot == F12020_NAME_NONE)
+         *slot = position;
+   }
+
+   // position of the mapped name, a mapping with matching team takes precedence over one without team.
+   // F12020_NAME_NONE if none matches.
+   int32_t Find(int team, int raceNumber) const
+   {
+      if ((raceNumber < 0) || (raceNumber >= F12020_NAME_NUMBERS))
+         return F12020_NAME_NONE;
+
+      if ((team >= 0) && (team < F12020_NAME_TEAMS) && (byTeam[team * F12020_NAME_NUMBERS + raceNumber] != F12020_NAME_NONE))
+         return byTeam[team * F12020_NAME_NUMBERS + raceNumber];
+      return byNumber[raceNumber];
+   }
+
+   int32_t byTeam[F12020_NAME_TEAMS * F12020_NAME_NUMBERS]; // [team * F12020_NAME_NUMBERS + race number]
+   int32_t byNumber[F12020_NAME_NUMBERS];                  // mappings without team
+};
@@ -1,162 +1,231 @@
-// Copyright 2018-2021 Andreas Jung
-// SPDX-License-Identifier: GPL-3.0-only
-
-#include "F12020ElementaryParser.h"
-
-#include <fstream>
-#include <type_traits>
-
-
-unsigned F12020ElementaryParser::ProceedPacket(const uint8_t* pData, unsigned len)
-{
-   if (len < sizeof(PacketHeader))
-      return len;
-
-   PacketHeader hdr;
-   memcpy(&hdr, pData, sizeof(PacketHeader));
-   if ((hdr.m_packetFormat != 2020) || (hdr.m_packetVersion != 1))
-      return len;
-
-   switch (hdr.m_packetId)
-   {
-   case 0:
-      memcpy(&motion, pData, sizeof(motion));
-      return sizeof(motion);
-      break;
-
-   case 1:
-      memcpy(&session, pData, sizeof(session));
-      return sizeof(session);
-      break;
-
-   case 2:
-      memcpy(&lap, pData, sizeof(lap));
-      return sizeof(lap);
-      break;
-
-   case 3:
-      memcpy(&event, pData, sizeof(event));
-
-      // Clear old Data when a new event starts
-      if (!strncmp((const char*)event.m_eventStringCode, "SSTA", 4))
-      {
-         motion = PacketMotionData{};
-         session = PacketSessionData{};
-         lap = PacketLapData{};
-         participants = PacketParticipantsData{};
-         setups = PacketCarSetupData{};
-         telemetry = PacketCarTelemetryData{};
-         status = PacketCarStatusData{};
-      }
-
-      return sizeof(event);
-      break;
-
-   case 4:
-      memcpy(&participants, pData, sizeof(participants));
-      return sizeof(participants);
-      break;
-
-   case 5:
-      memcpy(&setups, pData, sizeof(setups));
-      return sizeof(setups);
-      break;
-
-   case 6:
-      memcpy(&telemetry, pData, sizeof(telemetry));
-      return sizeof(telemetry);
-      break;
-
-   case 7:
-      memcpy(&status, pData, sizeof(status));
-      return sizeof(status);
-      break;
-
-   case 8:
-      memcpy(&classification, pData, sizeof(classification));
-      return sizeof(classification);
-      break;
-   }
-   return len;
-}
-
-const char* IdToTrackName(unsigned i)
-{
-   switch (i)
-   {
-   default:
-      return "unknown";
-
-   case 0:
-      return "Melbourne";
-
-   case 1:
-      return "Paul Ricard";
-
-   case 2:
-      return "Shanghai";
-   case 3:
-      return "Sakhir";
-   case 4:
-      return "Catalunya";
-
-   case 5:
-      return "Monaco";
-
-   case 6:
-      return "Montreal";
-
-   case 7:
-      return "Silverstone";
-
-   case 8:
-      return "Hockenheim";
-
-   case 9:
-      return "Hungaroring";
-
-   case 10:
-      return "Spa";
-
-   case 11:
-      return "Monza";
-
-   case 12:
-      return "Signapore";
-
-   case 13:
-      return "Suzuka";
-
-   case 14:
-      return "Abu Dhabi";
-
-   case 15:
-      return "Texas";
-   case 16:
-      return "Brazil";
-
-   case 17:
-      return "Austria";
-
-   case 18:
-      return"Sochi";
-
-   case 19:
-      return "Mexico";
-
-   case 20:
-      return "Baku";
-
-   case 21:
-      return "SakhirShort";
-
-   case 22:
-      return "SilverstoneShort";
-
-   case 23:
-      return "TexasShort";
-
-   case 24:
-      return "SuzukaShort";
-   }
-}
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "F12020ElementaryParser.h"
+
+#include <fstream>
+#include <stddef.h>
+
+
+namespace
+{
+   unsigned PacketSize(uint8_t packetId)
+   {
+      switch (packetId)
+      {
+      case 0: return sizeof(PacketMotionData);
+      case 1: return sizeof(PacketSessionData);
+      case 2: return sizeof(PacketLapData);
+      case 3: return sizeof(PacketEventData);
+      case 4: return sizeof(PacketParticipantsData);
+      case 5: return sizeof(PacketCarSetupData);
+      case 6: return sizeof(PacketCarTelemetryData);
+      case 7: return sizeof(PacketCarStatusData);
+      case 8: return sizeof(PacketFinalClassificationData);
+      }
+      return 0;
+   }
+}
+
+F12020PacketView F12020ElementaryParser::Inspect(const uint8_t* pData, unsigned len)
+{
+   F12020PacketView view;
+   if (len < sizeof(PacketHeader))
+      return view;
+
+   auto hdr = reinterpret_cast<const PacketHeader*>(pData);
+   if ((hdr->m_packetFormat != 2020) || (hdr->m_packetVersion != 1))
+      return view;
+
+   unsigned size = PacketSize(hdr->m_packetId);
+   if (!size || (len < size)) // unknown or truncated packet
+      return view;
+
+   view.header = hdr;
+   view.data = pData;
+   view.len = size;
+   return view;
+}
+
+unsigned F12020ElementaryParser::ProceedPacket(const uint8_t* pData, unsigned len)
+{
+   skipped = false;
+
+   // reject unsubscribed packets before the size check, only the header is read
+   if (len >= sizeof(PacketHeader))
+   {
+      auto hdr = reinterpret_cast<const PacketHeader*>(pData);
+      if ((hdr->m_packetFormat == 2020) && (hdr->m_packetVersion == 1) && (hdr->m_packetId < 32) && !(subscriptions & F12020PacketBit(hdr->m_packetId)))
+      {
+         lastPacket = F12020PacketView{};
+         skipped = PacketSize(hdr->m_packetId) && (len >= PacketSize(hdr->m_packetId));
+         return skipped ? PacketSize(hdr->m_packetId) : len;
+      }
+   }
+
+   F12020PacketView view = Inspect(pData, len);
+   lastPacket = view;
+   if (!view)
+      return len;
+
+   if (zeroCopy)
+      m_CopyConsumed(view);
+   else
+      m_Copy(view);
+
+   // Clear old Data when a new event starts
+   if ((view.header->m_packetId == 3) && (F12020EventKey(event) == F12020_EVENT_SESSION_STARTED))
+   {
+      motion = PacketMotionData{};
+      session = PacketSessionData{};
+      lap = PacketLapData{};
+      participants = PacketParticipantsData{};
+      setups = PacketCarSetupData{};
+      telemetry = PacketCarTelemetryData{};
+      status = PacketCarStatusData{};
+      m_complete &= F12020PacketBit(3) | F12020PacketBit(8);
+   }
+
+   return view.len;
+}
+
+void F12020ElementaryParser::m_Copy(const F12020PacketView& view)
+{
+   switch (view.header->m_packetId)
+   {
+   case 0: memcpy(&motion, view.data, sizeof(motion)); break;
+   case 1: memcpy(&session, view.data, sizeof(session)); break;
+   case 2: memcpy(&lap, view.data, sizeof(lap)); break;
+   case 3: memcpy(&event, view.data, sizeof(event)); break;
+   case 4: memcpy(&participants, view.data, sizeof(participants)); break;
+   case 5: memcpy(&setups, view.data, sizeof(setups)); break;
+   case 6: memcpy(&telemetry, view.data, sizeof(telemetry)); break;
+   case 7: memcpy(&status, view.data, sizeof(status)); break;
+   case 8: memcpy(&classification, view.data, sizeof(classification)); break;
+   }
+   m_complete |= F12020PacketBit(view.header->m_packetId);
+}
+
+void F12020ElementaryParser::m_CopyConsumed(const F12020PacketView& view)
+{
+   switch (view.header->m_packetId)
+   {
+   case 0: // not consumed, header only
+      motion.m_header = *view.header;
+      m_complete &= ~F12020PacketBit(0);
+      break;
+
+   case 1: // header + session scalars, marshal zones and weather forecast are not consumed
+      memcpy(&session, view.data, offsetof(PacketSessionData, m_marshalZones));
+      m_complete &= ~F12020PacketBit(1);
+      break;
+
+   case 5: // not consumed, header only
+      setups.m_header = *view.header;
+      m_complete &= ~F12020PacketBit(5);
+      break;
+
+   case 6: // decoded from the view by F12020CarStateStore, header only
+      telemetry.m_header = *view.header;
+      m_complete &= ~F12020PacketBit(6);
+      break;
+
+   case 7: // decoded from the view by F12020CarStateStore, header only
+      status.m_header = *view.header;
+      m_complete &= ~F12020PacketBit(7);
+      break;
+
+   // lap, event, participants and classification are (almost) completely consumed
+   default:
+      m_Copy(view);
+      break;
+   }
+}
+
+bool F12020ElementaryParser::m_Materialize(uint8_t packetId)
+{
+   if (!(m_complete & F12020PacketBit(packetId)) && lastPacket && (lastPacket.header->m_packetId == packetId))
+      m_Copy(lastPacket);
+   return (m_complete & F12020PacketBit(packetId)) != 0;
+}
+
+const char* IdToTrackName(unsigned i)
+{
+   switch (i)
+   {
+   default:
+      return "unknown";
+
+   case 0:
+      return "Melbourne";
+
+   case 1:
+      return "Paul Ricard";
+
+   case 2:
+      return "Shanghai";
+   case 3:
+      return "Sakhir";
+   case 4:
+      return "Catalunya";
+
+   case 5:
+      return "Monaco";
+
+   case 6:
+      return "Montreal";
+
+   case 7:
+      return "Silverstone";
+
+   case 8:
+      return "Hockenheim";
+
+   case 9:
+      return "Hungaroring";
+
+   case 10:
+      return "Spa";
+
+   case 11:
+      return "Monza";
+
+   case 12:
+      return "Signapore";
+
+   case 13:
+      return "Suzuka";
+
+   case 14:
+      return "Abu Dhabi";
+
+   case 15:
+      return "Texas";
+   case 16:
+      return "Brazil";
+
+   case 17:
+      return "Austria";
+
+   case 18:
+      return"Sochi";
+
+   case 19:
+      return "Mexico";
+
+   case 20:
+      return "Baku";
+
+   case 21:
+      return "SakhirShort";
+
+   case 22:
+      return "SilverstoneShort";
+
+   case 23:
+      return "TexasShort";
+
+   case 24:
+      return "SuzukaShort";
+   }
+}
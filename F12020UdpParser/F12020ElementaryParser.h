@@ -1,23 +1,76 @@
-// Copyright 2018-2021 Andreas Jung
-// SPDX-License-Identifier: GPL-3.0-only
-
-#pragma once
-#include <stdint.h>
-#include <string.h>
-#include <fstream>
-#include "F12020DataDefs.h"
-
-struct F12020ElementaryParser
-{
-   unsigned ProceedPacket(const uint8_t* pData, unsigned len);
-
-   PacketMotionData motion{};
-   PacketSessionData session{};
-   PacketLapData lap{};
-   PacketEventData event {};
-   PacketParticipantsData participants{};
-   PacketCarSetupData setups{};
-   PacketCarTelemetryData telemetry{};
-   PacketCarStatusData status{};
-   PacketFinalClassificationData classification{};
-};
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include <fstream>
+#include "F12020DataDefs.h"
+
+// Typed view of one validated packet inside a caller owned buffer.
+// All packet structs are packed (alignment 1), so the view is safe for any buffer address.
+// The view is only valid as long as the caller keeps the buffer unchanged.
+struct F12020PacketView
+{
+   const PacketHeader* header{ nullptr };
+   const uint8_t* data{ nullptr };
+   unsigned len{ 0 }; // size of the packet struct for header->m_packetId
+
+   template<typename T>
+   const T& As() const { return *reinterpret_cast<const T*>(data); }
+
+   explicit operator bool() const { return header != nullptr; }
+};
+
+// subscription bits of F12020ElementaryParser::subscriptions
+constexpr uint32_t F12020PacketBit(uint8_t packetId) { return 1u << packetId; }
+constexpr uint32_t F12020_PACKETS_ALL = (1u << 9) - 1; // packet ids 0..8
+
+struct F12020ElementaryParser
+{
+   unsigned ProceedPacket(const uint8_t* pData, unsigned len);
+
+   // check format, version, id and size of the packet at pData, returns an empty view if it can not be parsed
+   static F12020PacketView Inspect(const uint8_t* pData, unsigned len);
+
+   // zero copy mode: only the fields consumed by F12020SessionEngine are copied into the packet structs below,
+   // motion, setup, telemetry and status packets are only available via lastPacket.
+   bool zeroCopy{ false };
+   F12020PacketView lastPacket{}; // view of the last packet (empty if rejected), valid until the callers buffer changes
+
+   // packet ids which are parsed. Others are rejected after the header check, nothing of them is copied and
+   // lastPacket is empty with skipped set.
+   uint32_t subscriptions{ F12020_PACKETS_ALL };
+   bool skipped{ false }; // the last packet was valid, but not subscribed
+
+   // lazy decoding: the complete struct of the latest packet of the id. For packets zero copy mode keeps header only
+   // (or partially), e.g. motion and setups, it is copied from lastPacket on the first read after ProceedPacket, so only
+   // a consumer which actually reads them pays for the copy. nullptr if no complete struct is available, i.e. the
+   // retained one is partial and the last packet has another id, or no packet of the id arrived since the session start.
+   const PacketMotionData* Motion() { return m_Materialize(0) ? &motion : nullptr; }
+   const PacketSessionData* Session() { return m_Materialize(1) ? &session : nullptr; }
+   const PacketCarSetupData* Setups() { return m_Materialize(5) ? &setups : nullptr; }
+   const PacketCarTelemetryData* Telemetry() { return m_Materialize(6) ? &telemetry : nullptr; }
+   const PacketCarStatusData* Status() { return m_Materialize(7) ? &status : nullptr; }
+
+   // the structs were overwritten from outside (F12020SessionEngine::RestoreState): lastPacket refers to another buffer
+   // and the lazy structs are not the latest packets any more
+   void Restored() { lastPacket = F12020PacketView{}; m_complete = 0; }
+
+   PacketMotionData motion{};
+   PacketSessionData session{};
+   PacketLapData lap{};
+   PacketEventData event {};
+   PacketParticipantsData participants{};
+   PacketCarSetupData setups{};
+   PacketCarTelemetryData telemetry{};
+   PacketCarStatusData status{};
+   PacketFinalClassificationData classification{};
+
+private:
+   void m_Copy(const F12020PacketView& view);
+   void m_CopyConsumed(const F12020PacketView& view);
+   bool m_Materialize(uint8_t packetId); // false if the struct can not be completed
+
+   uint32_t m_complete{ 0 }; // subscription bits of the structs which completely hold the latest packet of their id
+};
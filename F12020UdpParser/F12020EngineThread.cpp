@@ -0,0 +1,345 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+// compiled without /clr, see F12020UdpParser.vcxproj
+
+#include "F12020EngineThread.h"
+#include "F12020Capture.h"
+#include "F12020Metrics.h"
+#include "F12020SessionEngine.h"
+#include "F12020SharedState.h"
+#include "F12020StateSnapshot.h"
+#include "F12020StreamServer.h"
+
+#include <assert.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+namespace
+{
+   constexpr unsigned TIMESTAMP_PREFIX = sizeof(int64_t); // each ring slot starts with the receive time, then the packet
+}
+
+struct F12020EngineThread::State
+{
+   explicit State(F12020Metrics& metrics) : metrics(metrics) {}
+
+   F12020Metrics& metrics;
+   F12020SessionEngine engine; // owned by the engine thread
+   F12020PacketRing ring;
+   F12020SnapshotBuffer snapshots;
+
+   std::thread thread;
+   std::mutex mutex;
+   std::condition_variable wake;
+   std::atomic<bool> idle{ false };
+   std::atomic<bool> stop{ false };
+#ifndef NDEBUG
+   std::atomic<bool> enqueuing{ false }; // Enqueue is running, to catch a second producer
+#endif
+
+   // held by the engine thread while it parses, so the capture is never swapped in the middle of a batch
+   mutable std::mutex captureMutex;
+   std::unique_ptr<F12020CaptureWriter> capture;
+   std::vector<uint8_t> keyframe; // serialized engine state for the capture
+
+   mutable std::mutex sharedMutex; // held by the engine thread while it publishes to the shared memory and the stream
+   F12020SharedStateWriter shared;
+   F12020StreamServer stream;
+   std::unique_ptr<F12020SharedState> records{ new F12020SharedState() }; // for the shared memory and the stream
+
+   // the derived state of the last snapshot, nothing is published before the first packet changed it
+   uint32_t publishedGeneration{ 0 };
+   uint32_t publishedFrames{ 0 };
+   size_t publishedEvents{ 0 };
+
+   void Run();
+   void Drain();
+   void Proceed(const uint8_t* p, unsigned len, int64_t timestampNs);
+   void Publish(); // if the derived state changed
+};
+
+void F12020EngineThread::State::Run()
+{
+   for (;;)
+   {
+      Drain();
+
+      unsigned len;
+      if (stop.load())
+      {
+         if (!ring.Front(len))
+         {
+            engine.FlushFrame();
+            Publish();
+            return;
+         }
+         continue;
+      }
+
+      // sleep until the receive thread queues a packet, idle is read by Enqueue after queuing.
+      // With a frame open, wake up after the frame timeout to derive it anyway (the rest was lost or the game paused).
+      const bool pending = engine.FramePending();
+      bool timeout = false;
+      {
+         std::unique_lock<std::mutex> lock(mutex);
+         idle.store(true);
+         std::atomic_thread_fence(std::memory_order_seq_cst);
+         auto ready = [&]() { unsigned l; return ring.Front(l) || stop.load(); };
+         if (pending)
+            timeout = !wake.wait_for(lock, std::chrono::nanoseconds(F12020_FRAME_TIMEOUT_NS), ready);
+         else
+            wake.wait(lock, ready);
+         idle.store(false);
+      }
+
+      if (timeout)
+      {
+         engine.FlushFrame();
+         Publish();
+      }
+   }
+}
+
+void F12020EngineThread::State::Drain()
+{
+   unsigned len;
+   const uint8_t* p = ring.Front(len);
+   if (!p)
+      return;
+
+   const int64_t start = F12020MetricsNow();
+   const int64_t drainNs = F12020_METRICS ? F12020CaptureNow() : 0; // same clock as the receive timestamps
+   unsigned queued = 0;
+   {
+      std::lock_guard<std::mutex> lock(captureMutex);
+      for (; p && (queued < F12020_RING_DEFAULT_SLOTS); p = ring.Front(len))
+      {
+         // parsed in place, the slot is released afterwards
+         int64_t timestampNs;
+         memcpy(&timestampNs, p, TIMESTAMP_PREFIX);
+         metrics.Record(F12020_STAGE_QUEUE_WAIT, drainNs - timestampNs);
+         Proceed(p + TIMESTAMP_PREFIX, len - TIMESTAMP_PREFIX, timestampNs);
+         ring.Pop();
+         ++queued;
+      }
+   }
+
+   metrics.Count(F12020_COUNTER_DRAINS);
+   metrics.Record(F12020_STAGE_QUEUE_DEPTH, queued);
+   metrics.Record(F12020_STAGE_DRAIN, F12020MetricsNow() - start);
+   Publish();
+}
+
+void F12020EngineThread::State::Proceed(const uint8_t* p, unsigned len, int64_t timestampNs)
+{
+   if (capture)
+      capture->Write(p, len, timestampNs);
+
+   while (len)
+   {
+      const int64_t start = F12020MetricsNow();
+      const unsigned processed = engine.ProceedPacket(p, len);
+
+      const F12020ElementaryParser& parser = engine.parser;
+      if (parser.lastPacket || parser.skipped)
+      {
+         const PacketHeader* header = reinterpret_cast<const PacketHeader*>(p);
+         metrics.RecordPacket(header->m_packetId, F12020MetricsNow() - start);
+         metrics.Count(parser.skipped ? F12020_COUNTER_SKIPPED : F12020_COUNTER_PARSED);
+      }
+      else
+      {
+         metrics.RecordPacket(F12020_METRICS_PACKET_IDS, F12020MetricsNow() - start);
+         metrics.Count(F12020_COUNTER_INVALID);
+      }
+
+      len -= processed;
+      p += processed;
+   }
+
+   // also makes captures started in the middle of a session replayable
+   const F12020PacketView& last = engine.parser.lastPacket;
+   if (capture && last && capture->KeyframeDue(*last.header))
+   {
+      engine.SaveState(keyframe);
+      capture->WriteKeyframe(*last.header, keyframe.data(), static_cast<unsigned>(keyframe.size()), timestampNs);
+   }
+}
+
+void F12020EngineThread::State::Publish()
+{
+   // the packets of an open frame change nothing a reader sees before the frame is derived
+   if ((engine.generation == publishedGeneration) && (engine.frames == publishedFrames) && (engine.events.size() == publishedEvents))
+      return;
+
+   const int64_t start = F12020MetricsNow();
+   snapshots.Publish(engine);
+   {
+      std::lock_guard<std::mutex> lock(sharedMutex);
+      const bool streaming = stream.Running();
+      if (shared.IsOpen() || streaming)
+      {
+         records->Capture(engine);
+         shared.Publish(*records);
+         if (streaming)
+            stream.Publish(*records);
+      }
+   }
+   publishedGeneration = engine.generation;
+   publishedFrames = engine.frames;
+   publishedEvents = engine.events.size();
+   metrics.Record(F12020_STAGE_PUBLISH, F12020MetricsNow() - start);
+}
+
+F12020EngineThread::F12020EngineThread(F12020Metrics& metrics)
+{
+   m_state = new State(metrics);
+   m_state->thread = std::thread([this]() { m_state->Run(); });
+}
+
+F12020EngineThread::~F12020EngineThread()
+{
+   m_state->stop.store(true);
+   {
+      std::lock_guard<std::mutex> lock(m_state->mutex);
+      m_state->wake.notify_one();
+   }
+   m_state->thread.join();
+
+   StopCapture();
+   StopSharing();
+   StopStreaming();
+   delete m_state;
+}
+
+bool F12020EngineThread::Enqueue(const uint8_t* pData, unsigned len)
+{
+   State& state = *m_state;
+#ifndef NDEBUG
+   const bool otherProducer = state.enqueuing.exchange(true, std::memory_order_acquire);
+   assert(!otherProducer && "F12020EngineThread::Enqueue called from two threads at once");
+   struct Leave { std::atomic<bool>& enqueuing; ~Leave() { enqueuing.store(false, std::memory_order_release); } } leave{ state.enqueuing };
+#endif
+   const int64_t start = F12020MetricsNow();
+   state.metrics.Count(F12020_COUNTER_RECEIVED);
+   state.metrics.Count(F12020_COUNTER_BYTES, len);
+
+   uint8_t* slot = state.ring.BeginWrite();
+   if (!slot)
+   {
+      state.metrics.Count(F12020_COUNTER_DROPPED);
+      return false;
+   }
+
+   // stamped here, the engine thread may pick the packet up later
+   const unsigned slotLen = TIMESTAMP_PREFIX + len;
+   if (slotLen <= F12020_RING_SLOT_SIZE)
+   {
+      const int64_t timestampNs = F12020CaptureNow();
+      memcpy(slot, &timestampNs, TIMESTAMP_PREFIX);
+      memcpy(slot + TIMESTAMP_PREFIX, pData, len);
+   }
+   state.ring.CommitWrite(slotLen); // counted as oversized if it does not fit
+
+   // the store to the ring must be visible before idle is read, see State::Run
+   std::atomic_thread_fence(std::memory_order_seq_cst);
+   if (state.idle.load())
+   {
+      std::lock_guard<std::mutex> lock(state.mutex);
+      state.wake.notify_one();
+   }
+
+   if (slotLen > F12020_RING_SLOT_SIZE)
+      state.metrics.Count(F12020_COUNTER_DROPPED);
+   state.metrics.Record(F12020_STAGE_ENQUEUE, F12020MetricsNow() - start);
+   return slotLen <= F12020_RING_SLOT_SIZE;
+}
+
+bool F12020EngineThread::Read(F12020EngineSnapshot& snapshot, F12020SnapshotHistory& history, uint64_t& sequence) const
+{
+   return m_state->snapshots.Read(snapshot, history, sequence);
+}
+
+bool F12020EngineThread::StartCapture(const char* path)
+{
+   StopCapture();
+
+   std::unique_ptr<F12020CaptureWriter> capture(new F12020CaptureWriter());
+   if (!capture->Open(path))
+      return false;
+
+   std::lock_guard<std::mutex> lock(m_state->captureMutex);
+   m_state->capture = std::move(capture);
+   return true;
+}
+
+void F12020EngineThread::StopCapture()
+{
+   std::unique_ptr<F12020CaptureWriter> capture;
+   {
+      std::lock_guard<std::mutex> lock(m_state->captureMutex);
+      capture = std::move(m_state->capture);
+   }
+
+   if (capture)
+      capture->Close(); // writes the index, outside the lock
+}
+
+bool F12020EngineThread::Capturing() const
+{
+   std::lock_guard<std::mutex> lock(m_state->captureMutex);
+   return m_state->capture != nullptr;
+}
+
+uint64_t F12020EngineThread::PacketsCaptured() const
+{
+   std::lock_guard<std::mutex> lock(m_state->captureMutex);
+   return m_state->capture ? m_state->capture->Packets() : 0;
+}
+
+bool F12020EngineThread::StartSharing(const char* name)
+{
+   std::lock_guard<std::mutex> lock(m_state->sharedMutex);
+   return m_state->shared.Open(name);
+}
+
+void F12020EngineThread::StopSharing()
+{
+   std::lock_guard<std::mutex> lock(m_state->sharedMutex);
+   m_state->shared.Close();
+}
+
+bool F12020EngineThread::Sharing() const
+{
+   std::lock_guard<std::mutex> lock(m_state->sharedMutex);
+   return m_state->shared.IsOpen();
+}
+
+bool F12020EngineThread::StartStreaming(uint16_t port, const char* bindAddr)
+{
+   std::lock_guard<std::mutex> lock(m_state->sharedMutex);
+   return m_state->stream.Start(port, bindAddr);
+}
+
+void F12020EngineThread::StopStreaming()
+{
+   std::lock_guard<std::mutex> lock(m_state->sharedMutex);
+   m_state->stream.Stop();
+}
+
+F12020StreamStats F12020EngineThread::StreamStats() const
+{
+   return m_state->stream.Stats();
+}
+
+F12020PacketRingStats F12020EngineThread::RingStats() const
+{
+   return m_state->ring.Stats();
+}
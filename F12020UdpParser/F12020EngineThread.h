@@ -0,0 +1,55 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+#include <stdint.h>
+#include "F12020PacketRing.h"
+#include "F12020StreamServer.h"
+
+struct F12020EngineSnapshot;
+struct F12020SnapshotHistory;
+struct F12020Metrics;
+
+// Runs the session engine on its own thread, so parsing never waits for the UI and the UI never waits for parsing.
+// The receive thread queues the datagrams into a F12020PacketRing, the engine thread parses them as they arrive
+// (an open frame is derived after F12020_FRAME_TIMEOUT_NS without packets) and publishes a F12020EngineSnapshot
+// whenever the derived state changed. Any thread reads the latest snapshot without blocking (see F12020SnapshotBuffer).
+// The implementation is native only (<thread> is not available with /clr), the header is safe for managed code.
+struct F12020EngineThread
+{
+   explicit F12020EngineThread(F12020Metrics& metrics);
+   ~F12020EngineThread(); // parses the queued packets, then stops
+   F12020EngineThread(const F12020EngineThread&) = delete;
+   F12020EngineThread& operator=(const F12020EngineThread&) = delete;
+
+   // receive thread: copy one datagram with its receive time into the packet ring, false if it was dropped.
+   // The ring has a single producer: calls from two threads at once corrupt it, debug builds assert on that.
+   bool Enqueue(const uint8_t* pData, unsigned len);
+
+   // any thread: the latest state if it is newer than sequence (0: none read yet) and the events and laps history
+   // is missing, see F12020SnapshotBuffer::Read
+   bool Read(F12020EngineSnapshot& snapshot, F12020SnapshotHistory& history, uint64_t& sequence) const;
+
+   // record all parsed packets with their receive time into a capture file (see F12020Capture.h), from any thread
+   bool StartCapture(const char* path);
+   void StopCapture();
+   bool Capturing() const;
+   uint64_t PacketsCaptured() const;
+
+   // also publish the derived state into a shared memory segment for other local processes (see F12020SharedState.h),
+   // written from the next derived frame on
+   bool StartSharing(const char* name);
+   void StopSharing();
+   bool Sharing() const;
+
+   // also stream the derived state to remote clients over TCP / WebSocket (see F12020StreamServer.h), from the next derived frame on
+   bool StartStreaming(uint16_t port, const char* bindAddr = nullptr);
+   void StopStreaming();
+   F12020StreamStats StreamStats() const;
+
+   F12020PacketRingStats RingStats() const;
+
+private:
+   struct State;
+   State* m_state;
+};
@@ -0,0 +1,128 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "F12020LapHistory.h"
+
+#include <algorithm>
+#include <iterator>
+#include <string.h>
+
+void F12020LapHistory::SetCrossings(int car, int lapNr, const float (&crossings)[F12020_SECTORS])
+{
+   const int lapIdx = lapNr - 1;
+   memcpy(&m_Store(car, lapIdx / F12020_LAP_CHUNK).crossings[(lapIdx % F12020_LAP_CHUNK) * F12020_SECTORS], crossings, sizeof(crossings));
+   m_SetRecent(car, lapNr, crossings);
+}
+
+void F12020LapHistory::Clear()
+{
+   m_used = 0;
+   for (auto& chunks : m_cars)
+      chunks.clear(); // keeps the capacity
+   std::fill(std::begin(m_recentTop), std::end(m_recentTop), -1);
+}
+
+void F12020LapHistory::Save(std::vector<uint8_t>& state) const
+{
+   for (const auto& chunks : m_cars)
+   {
+      const uint32_t count = static_cast<uint32_t>(chunks.size());
+      const uint8_t* p = reinterpret_cast<const uint8_t*>(&count);
+      state.insert(state.end(), p, p + sizeof(count));
+
+      for (const Chunk* chunk : chunks)
+      {
+         p = reinterpret_cast<const uint8_t*>(chunk);
+         state.insert(state.end(), p, p + sizeof(Chunk));
+      }
+   }
+}
+
+bool F12020LapHistory::Restore(const uint8_t* pState, const uint8_t* pEnd)
+{
+   Clear();
+   for (int car = 0; car < F12020_MAX_CARS; ++car)
+   {
+      uint32_t count;
+      if (static_cast<size_t>(pEnd - pState) < sizeof(count))
+         return false;
+      memcpy(&count, pState, sizeof(count));
+      pState += sizeof(count);
+
+      if (static_cast<size_t>(pEnd - pState) / sizeof(Chunk) < count)
+         return false;
+
+      for (uint32_t i = 0; i < count; ++i)
+      {
+         memcpy(&m_Store(car, static_cast<int>(i)), pState, sizeof(Chunk));
+         pState += sizeof(Chunk);
+      }
+
+      // the chunks end with laps not driven yet, the ring ends at the last recorded crossing like before saving
+      int last = StoredLaps(car) * F12020_SECTORS - 1;
+      while ((last >= 0) && !m_CrossingStored(car, last))
+         --last;
+      if (last < 0)
+         continue;
+
+      const int lastLap = last / F12020_SECTORS + 1;
+      for (int lapNr = std::max(lastLap - (RECENT + F12020_SECTORS - 1) / F12020_SECTORS, 0) + 1; lapNr <= lastLap; ++lapNr)
+         m_SetRecent(car, lapNr, &m_cars[car][(lapNr - 1) / F12020_LAP_CHUNK]->crossings[((lapNr - 1) % F12020_LAP_CHUNK) * F12020_SECTORS]);
+   }
+   return pState == pEnd;
+}
+
+float F12020LapHistory::m_CrossingStored(int car, int n) const
+{
+   constexpr int CROSSINGS = F12020_LAP_CHUNK * F12020_SECTORS;
+   if (n < 0)
+      return 0;
+
+   const Chunk* chunk = m_Find(car, n / CROSSINGS);
+   return chunk ? chunk->crossings[n % CROSSINGS] : 0;
+}
+
+bool F12020LapHistory::m_LatestCommonCrossingStored(int a, int b, int n, float& timeA, float& timeB) const
+{
+   for (; n >= 0; --n)
+   {
+      timeA = Crossing(a, n);
+      timeB = Crossing(b, n);
+      if (timeA && timeB)
+         return true;
+   }
+   return false;
+}
+
+F12020LapHistory::Chunk& F12020LapHistory::m_Store(int car, int chunk)
+{
+   // a car first seen in a later lap takes the chunks before as well, the table stays dense
+   auto& chunks = m_cars[car];
+   while (static_cast<size_t>(chunk) >= chunks.size())
+   {
+      if (m_used == m_arena.size())
+         m_arena.emplace_back(new Chunk);
+
+      Chunk* fresh = m_arena[m_used++].get();
+      memset(fresh, 0, sizeof(Chunk)); // may have been used before Clear()
+      chunks.push_back(fresh);
+   }
+   return *chunks[chunk];
+}
+
+void F12020LapHistory::m_SetRecent(int car, int lapNr, const float* crossings)
+{
+   // crossings entering the ring above the previous highest one are not recorded yet
+   const int first = (lapNr - 1) * F12020_SECTORS;
+   const int last = first + F12020_SECTORS - 1;
+   int& top = m_recentTop[car];
+   for (int n = std::max(top + 1, last - RECENT + 1); n <= last; ++n)
+      m_recent[car][n & (RECENT - 1)] = 0;
+   top = std::max(top, last);
+
+   for (int n = first; n <= last; ++n)
+   {
+      if (top - n < RECENT)
+         m_recent[car][n & (RECENT - 1)] = crossings[n - first];
+   }
+}
@@ -0,0 +1,114 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+#include <stdint.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "F12020CarStateStore.h"
+
+constexpr int F12020_SECTORS = 3;
+constexpr int F12020_LAP_CHUNK = 16; // laps per chunk of F12020LapHistory
+
+struct F12020LapTimes
+{
+   float sector1;
+   float sector2;
+   float lap;
+   float lapsAccumulated;
+};
+
+// Lap times and sector crossings of all cars. The laps are stored in chunks of F12020_LAP_CHUNK laps, taken from an
+// arena when a car reaches the first lap of a chunk, so laps not driven yet cost nothing and there is no lap limit.
+// Clear() returns all chunks to the arena without freeing or touching them.
+struct F12020LapHistory
+{
+   F12020LapHistory() { Clear(); }
+
+   // lapNr counts from 1, laps not stored read as zero
+   F12020LapTimes Lap(int car, int lapNr) const;
+   F12020LapTimes& At(int car, int lapNr); // stores the lap if needed, lapNr >= 1
+
+   // cumulative race time at sector crossing n = (lapNr - 1) * F12020_SECTORS + sector, 0 if not recorded
+   float Crossing(int car, int n) const;
+   void SetCrossings(int car, int lapNr, const float (&crossings)[F12020_SECTORS]); // lapNr >= 1
+
+   // race times of cars a and b at the latest crossing up to n both have recorded, false if none
+   bool LatestCommonCrossing(int a, int b, int n, float& timeA, float& timeB) const;
+
+   int StoredLaps(int car) const { return static_cast<int>(m_cars[car].size()) * F12020_LAP_CHUNK; }
+
+   void Clear();
+
+   // for F12020SessionEngine::SaveState / RestoreState, Restore consumes the rest of the state
+   void Save(std::vector<uint8_t>& state) const;
+   bool Restore(const uint8_t* pState, const uint8_t* pEnd);
+
+private:
+   struct Chunk
+   {
+      F12020LapTimes laps[F12020_LAP_CHUNK];
+      float crossings[F12020_LAP_CHUNK * F12020_SECTORS];
+   };
+
+   // the delta and gap updates look up crossings for every pair of cars, nearly always of the last laps driven.
+   // The latest crossings are mirrored in a ring per car, so these lookups stay in a few cache lines without indirection.
+   static constexpr int RECENT = 16; // crossings (5 laps), power of 2
+
+   const Chunk* m_Find(int car, int chunk) const
+   {
+      const auto& chunks = m_cars[car];
+      return (static_cast<size_t>(chunk) < chunks.size()) ? chunks[chunk] : nullptr;
+   }
+
+   Chunk& m_Store(int car, int chunk);
+   float m_CrossingStored(int car, int n) const; // not inline, keeps the inline lookups small
+   bool m_LatestCommonCrossingStored(int a, int b, int n, float& timeA, float& timeB) const;
+   void m_SetRecent(int car, int lapNr, const float* crossings);
+
+   std::vector<std::unique_ptr<Chunk>> m_arena; // every chunk ever allocated, [0, m_used) are in use
+   size_t m_used{ 0 };
+   std::vector<Chunk*> m_cars[F12020_MAX_CARS];  // chunks of each car in lap order
+
+   float m_recent[F12020_MAX_CARS][RECENT]{}; // crossing n at n % RECENT
+   int m_recentTop[F12020_MAX_CARS];          // highest crossing in m_recent, -1 if none
+};
+
+// the lookups are inline, the lap update calls them for every car and the delta and gap updates for every pair of cars
+
+inline F12020LapTimes F12020LapHistory::Lap(int car, int lapNr) const
+{
+   if (lapNr < 1)
+      return F12020LapTimes{};
+
+   const Chunk* chunk = m_Find(car, (lapNr - 1) / F12020_LAP_CHUNK);
+   return chunk ? chunk->laps[(lapNr - 1) % F12020_LAP_CHUNK] : F12020LapTimes{};
+}
+
+inline F12020LapTimes& F12020LapHistory::At(int car, int lapNr)
+{
+   const int chunk = (lapNr - 1) / F12020_LAP_CHUNK;
+   auto& chunks = m_cars[car];
+   return ((static_cast<size_t>(chunk) < chunks.size()) ? *chunks[chunk] : m_Store(car, chunk)).laps[(lapNr - 1) % F12020_LAP_CHUNK];
+}
+
+inline float F12020LapHistory::Crossing(int car, int n) const
+{
+   if ((n >= 0) && (static_cast<unsigned>(m_recentTop[car] - n) < RECENT))
+      return m_recent[car][n & (RECENT - 1)];
+   return m_CrossingStored(car, n);
+}
+
+inline bool F12020LapHistory::LatestCommonCrossing(int a, int b, int n, float& timeA, float& timeB) const
+{
+   // nearly always the first candidate, in the rings of both cars
+   if ((n >= 0) && (n <= std::min(m_recentTop[a], m_recentTop[b])) && (n > std::max(m_recentTop[a], m_recentTop[b]) - RECENT))
+   {
+      timeA = m_recent[a][n & (RECENT - 1)];
+      timeB = m_recent[b][n & (RECENT - 1)];
+      if (timeA && timeB)
+         return true;
+   }
+   return m_LatestCommonCrossingStored(a, b, n, timeA, timeB);
+}
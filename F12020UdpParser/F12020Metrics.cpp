@@ -0,0 +1,269 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+// compiled without /clr, see F12020UdpParser.vcxproj
+
+#include "F12020Metrics.h"
+
+#include <atomic>
+#include <chrono>
+#include <stdio.h>
+
+namespace
+{
+   const char* const STAGE_NAMES[F12020_STAGE_COUNT] =
+   {
+      "enqueue", "queue_wait", "drain", "proceed", "publish", "project", "project_drivers", "queue_depth"
+   };
+
+   const char* const COUNTER_NAMES[F12020_COUNTER_COUNT] =
+   {
+      "received", "dropped", "bytes", "parsed", "invalid", "drains", "skipped"
+   };
+
+   const char* const PACKET_NAMES[F12020_METRICS_PACKET_IDS] =
+   {
+      "motion", "session", "lap", "event", "participants", "setups", "telemetry", "status", "classification", "lobby"
+   };
+
+   unsigned HighestBit(uint64_t value)
+   {
+      unsigned bit = 0;
+      while (value >>= 1)
+         ++bit;
+      return bit;
+   }
+}
+
+const char* F12020MetricStageName(F12020MetricStage stage)
+{
+   return (stage < F12020_STAGE_COUNT) ? STAGE_NAMES[stage] : "";
+}
+
+const char* F12020MetricCounterName(F12020MetricCounter counter)
+{
+   return (counter < F12020_COUNTER_COUNT) ? COUNTER_NAMES[counter] : "";
+}
+
+const char* F12020MetricPacketName(unsigned packetId)
+{
+   return (packetId < F12020_METRICS_PACKET_IDS) ? PACKET_NAMES[packetId] : "";
+}
+
+unsigned F12020HistogramBucket(uint64_t value)
+{
+   if (value < 2 * F12020_HISTOGRAM_SUB)
+      return static_cast<unsigned>(value);
+
+   const unsigned bit = HighestBit(value);
+   const unsigned sub = static_cast<unsigned>(value >> (bit - F12020_HISTOGRAM_SUB_BITS)) & (F12020_HISTOGRAM_SUB - 1);
+   return (bit - F12020_HISTOGRAM_SUB_BITS + 1) * F12020_HISTOGRAM_SUB + sub;
+}
+
+uint64_t F12020HistogramBucketLimit(unsigned bucket)
+{
+   if (bucket < 2 * F12020_HISTOGRAM_SUB)
+      return bucket;
+
+   const unsigned shift = bucket / F12020_HISTOGRAM_SUB - 1;
+   const uint64_t lower = static_cast<uint64_t>(F12020_HISTOGRAM_SUB + bucket % F12020_HISTOGRAM_SUB) << shift;
+   return lower + ((uint64_t(1) << shift) - 1);
+}
+
+uint64_t F12020HistogramSnapshot::Percentile(double percent) const
+{
+   if (!count)
+      return 0;
+
+   uint64_t rank = static_cast<uint64_t>(count * percent / 100);
+   if (rank < 1)
+      rank = 1;
+
+   uint64_t seen = 0;
+   for (unsigned i = 0; i < F12020_HISTOGRAM_BUCKETS; ++i)
+   {
+      seen += buckets[i];
+      if (seen >= rank)
+         return (F12020HistogramBucketLimit(i) < max) ? F12020HistogramBucketLimit(i) : max;
+   }
+   return max;
+}
+
+#if F12020_METRICS
+int64_t F12020MetricsNow()
+{
+   return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+namespace
+{
+   int64_t UnixNow()
+   {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+   }
+
+   struct Histogram
+   {
+      std::atomic<uint64_t> sum{ 0 };
+      std::atomic<uint64_t> min{ UINT64_MAX };
+      std::atomic<uint64_t> max{ 0 };
+      std::atomic<uint64_t> buckets[F12020_HISTOGRAM_BUCKETS] = {};
+
+      void Record(uint64_t value)
+      {
+         buckets[F12020HistogramBucket(value)].fetch_add(1, std::memory_order_relaxed);
+         sum.fetch_add(value, std::memory_order_relaxed);
+
+         uint64_t current = min.load(std::memory_order_relaxed);
+         while ((value < current) && !min.compare_exchange_weak(current, value, std::memory_order_relaxed))
+            ;
+         current = max.load(std::memory_order_relaxed);
+         while ((value > current) && !max.compare_exchange_weak(current, value, std::memory_order_relaxed))
+            ;
+      }
+
+      void Snapshot(F12020HistogramSnapshot& snapshot) const
+      {
+         snapshot.count = 0;
+         for (unsigned i = 0; i < F12020_HISTOGRAM_BUCKETS; ++i)
+         {
+            snapshot.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+            snapshot.count += snapshot.buckets[i];
+         }
+         snapshot.sum = sum.load(std::memory_order_relaxed);
+         snapshot.min = snapshot.count ? min.load(std::memory_order_relaxed) : 0;
+         snapshot.max = max.load(std::memory_order_relaxed);
+      }
+
+      void Reset()
+      {
+         for (auto& bucket : buckets)
+            bucket.store(0, std::memory_order_relaxed);
+         sum.store(0, std::memory_order_relaxed);
+         min.store(UINT64_MAX, std::memory_order_relaxed);
+         max.store(0, std::memory_order_relaxed);
+      }
+   };
+
+   FILE* OpenForWriting(const char* path)
+   {
+#ifdef _MSC_VER
+      FILE* file = nullptr;
+      if (fopen_s(&file, path, "w"))
+         return nullptr;
+      return file;
+#else
+      return fopen(path, "w");
+#endif
+   }
+
+   void PrintHistogram(FILE* file, const char* name, const F12020HistogramSnapshot& h, double scale)
+   {
+      if (!h.count)
+         return;
+
+      fprintf(file, "  %-16s %10llu %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n", name,
+         static_cast<unsigned long long>(h.count), h.min / scale, h.Mean() / scale,
+         h.Percentile(50) / scale, h.Percentile(90) / scale, h.Percentile(99) / scale, h.Percentile(99.9) / scale, h.max / scale);
+   }
+}
+
+struct F12020Metrics::State
+{
+   std::atomic<int64_t> sinceNs{ UnixNow() };
+   Histogram stages[F12020_STAGE_COUNT];
+   Histogram packets[F12020_METRICS_PACKET_IDS];
+   std::atomic<uint64_t> counters[F12020_COUNTER_COUNT] = {};
+};
+
+F12020Metrics::F12020Metrics()
+{
+   m_state = new State();
+}
+
+F12020Metrics::~F12020Metrics()
+{
+   delete m_state;
+}
+
+void F12020Metrics::Record(F12020MetricStage stage, int64_t value)
+{
+   if (stage < F12020_STAGE_COUNT)
+      m_state->stages[stage].Record(value > 0 ? static_cast<uint64_t>(value) : 0);
+}
+
+void F12020Metrics::RecordPacket(unsigned packetId, int64_t ns)
+{
+   const uint64_t value = ns > 0 ? static_cast<uint64_t>(ns) : 0;
+   m_state->stages[F12020_STAGE_PROCEED].Record(value);
+   if (packetId < F12020_METRICS_PACKET_IDS)
+      m_state->packets[packetId].Record(value);
+}
+
+void F12020Metrics::Count(F12020MetricCounter counter, uint64_t n)
+{
+   if (counter < F12020_COUNTER_COUNT)
+      m_state->counters[counter].fetch_add(n, std::memory_order_relaxed);
+}
+
+void F12020Metrics::Snapshot(F12020MetricsSnapshot& snapshot) const
+{
+   snapshot.sinceNs = m_state->sinceNs.load(std::memory_order_relaxed);
+   snapshot.takenNs = UnixNow();
+   for (unsigned i = 0; i < F12020_STAGE_COUNT; ++i)
+      m_state->stages[i].Snapshot(snapshot.stages[i]);
+   for (unsigned i = 0; i < F12020_METRICS_PACKET_IDS; ++i)
+      m_state->packets[i].Snapshot(snapshot.packets[i]);
+   for (unsigned i = 0; i < F12020_COUNTER_COUNT; ++i)
+      snapshot.counters[i] = m_state->counters[i].load(std::memory_order_relaxed);
+}
+
+void F12020Metrics::Reset()
+{
+   for (auto& stage : m_state->stages)
+      stage.Reset();
+   for (auto& packet : m_state->packets)
+      packet.Reset();
+   for (auto& counter : m_state->counters)
+      counter.store(0, std::memory_order_relaxed);
+   m_state->sinceNs.store(UnixNow(), std::memory_order_relaxed);
+}
+
+bool F12020Metrics::Dump(const F12020MetricsSnapshot& snapshot, const char* path)
+{
+   FILE* file = OpenForWriting(path);
+   if (!file)
+      return false;
+
+   const double seconds = (snapshot.takenNs - snapshot.sinceNs) * 1e-9;
+   fprintf(file, "F1 2020 parser metrics over %.1f s\n\n", seconds);
+
+   fprintf(file, "counters\n");
+   for (unsigned i = 0; i < F12020_COUNTER_COUNT; ++i)
+   {
+      fprintf(file, "  %-16s %14llu %12.1f/s\n", COUNTER_NAMES[i], static_cast<unsigned long long>(snapshot.counters[i]),
+         seconds > 0 ? snapshot.counters[i] / seconds : 0);
+   }
+
+   const char* columns = "  %-16s %10s %10s %10s %10s %10s %10s %10s %10s\n";
+   fprintf(file, "\nstages (us)\n");
+   fprintf(file, columns, "", "count", "min", "mean", "p50", "p90", "p99", "p99.9", "max");
+   for (unsigned i = 0; i < F12020_STAGE_COUNT; ++i)
+   {
+      if (i != F12020_STAGE_QUEUE_DEPTH)
+         PrintHistogram(file, STAGE_NAMES[i], snapshot.stages[i], 1000);
+   }
+
+   fprintf(file, "\nproceed by packet id (us)\n");
+   fprintf(file, columns, "", "count", "min", "mean", "p50", "p90", "p99", "p99.9", "max");
+   for (unsigned i = 0; i < F12020_METRICS_PACKET_IDS; ++i)
+      PrintHistogram(file, PACKET_NAMES[i], snapshot.packets[i], 1000);
+
+   fprintf(file, "\nqueue depth (packets)\n");
+   fprintf(file, columns, "", "count", "min", "mean", "p50", "p90", "p99", "p99.9", "max");
+   PrintHistogram(file, STAGE_NAMES[F12020_STAGE_QUEUE_DEPTH], snapshot.stages[F12020_STAGE_QUEUE_DEPTH], 1);
+
+   const bool ok = !ferror(file);
+   return (fclose(file) == 0) && ok;
+}
+#endif
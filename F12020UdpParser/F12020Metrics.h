@@ -0,0 +1,111 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+#include <stdint.h>
+
+// Low overhead instrumentation of the ingest pipeline: latency histograms per stage and per packet id plus counters.
+// Recording is lock free (relaxed atomics), so the receive, engine and UI threads record concurrently,
+// a snapshot may be taken from any thread. The implementation is native only (<atomic> is not available with /clr).
+// Build with F12020_METRICS=0 to strip it: all members become empty inline functions and the call sites vanish.
+
+#ifndef F12020_METRICS
+#define F12020_METRICS 1
+#endif
+
+// HDR style log linear buckets: exact below 2 * SUB, above F12020_HISTOGRAM_SUB buckets per power of 2 (<= 12.5% error)
+constexpr unsigned F12020_HISTOGRAM_SUB_BITS = 3;
+constexpr unsigned F12020_HISTOGRAM_SUB = 1u << F12020_HISTOGRAM_SUB_BITS;
+constexpr unsigned F12020_HISTOGRAM_BUCKETS = (64 - F12020_HISTOGRAM_SUB_BITS + 1) * F12020_HISTOGRAM_SUB;
+constexpr unsigned F12020_METRICS_PACKET_IDS = 10; // F1 2020 packet ids 0..9
+
+enum F12020MetricStage
+{
+   F12020_STAGE_ENQUEUE,         // receive thread: copy of a datagram into the packet ring
+   F12020_STAGE_QUEUE_WAIT,      // receive time until the engine thread picks the packet up
+   F12020_STAGE_DRAIN,           // engine thread: parsing of all queued packets and the snapshot
+   F12020_STAGE_PROCEED,         // one datagram through the session engine (also per packet id, see F12020MetricsSnapshot)
+   F12020_STAGE_PUBLISH,         // engine thread: copy of the engine state into a snapshot
+   F12020_STAGE_PROJECT,         // UI thread: copy of the latest snapshot onto the managed objects
+   F12020_STAGE_PROJECT_DRIVERS, // the per car loop of the projection
+   F12020_STAGE_QUEUE_DEPTH,     // not a latency: packets queued at the start of a drain
+   F12020_STAGE_COUNT
+};
+
+enum F12020MetricCounter
+{
+   F12020_COUNTER_RECEIVED,  // datagrams handed to the parser
+   F12020_COUNTER_DROPPED,   // datagrams lost before parsing (ring full or oversized)
+   F12020_COUNTER_BYTES,     // bytes received
+   F12020_COUNTER_PARSED,    // packets parsed by the engine
+   F12020_COUNTER_INVALID,   // datagrams the engine did not recognize
+   F12020_COUNTER_DRAINS,    // wake ups of the engine thread which found packets
+   F12020_COUNTER_SKIPPED,   // packets rejected by the subscriptions of the parser
+   F12020_COUNTER_COUNT
+};
+
+struct F12020HistogramSnapshot
+{
+   uint64_t count;
+   uint64_t sum;
+   uint64_t min;
+   uint64_t max;
+   uint64_t buckets[F12020_HISTOGRAM_BUCKETS];
+
+   double Mean() const { return count ? static_cast<double>(sum) / count : 0; }
+   uint64_t Percentile(double percent) const; // upper bound of the bucket holding the percentile, 0 if empty
+};
+
+struct F12020MetricsSnapshot
+{
+   int64_t sinceNs; // unix time in ns of the start (or the last Reset())
+   int64_t takenNs;
+   F12020HistogramSnapshot stages[F12020_STAGE_COUNT];
+   F12020HistogramSnapshot packets[F12020_METRICS_PACKET_IDS]; // F12020_STAGE_PROCEED by packet id
+   uint64_t counters[F12020_COUNTER_COUNT];
+};
+
+const char* F12020MetricStageName(F12020MetricStage stage);
+const char* F12020MetricCounterName(F12020MetricCounter counter);
+const char* F12020MetricPacketName(unsigned packetId);
+unsigned F12020HistogramBucket(uint64_t value);
+uint64_t F12020HistogramBucketLimit(unsigned bucket); // largest value of the bucket
+
+#if F12020_METRICS
+// steady clock in ns, only for differences
+int64_t F12020MetricsNow();
+
+struct F12020Metrics
+{
+   F12020Metrics();
+   ~F12020Metrics();
+   F12020Metrics(const F12020Metrics&) = delete;
+   F12020Metrics& operator=(const F12020Metrics&) = delete;
+
+   void Record(F12020MetricStage stage, int64_t value);
+   void RecordPacket(unsigned packetId, int64_t ns); // F12020_STAGE_PROCEED, also by packet id if known
+   void Count(F12020MetricCounter counter, uint64_t n = 1);
+
+   void Snapshot(F12020MetricsSnapshot& snapshot) const; // relaxed: concurrent records may be half included
+   void Reset();
+
+   // text report of the snapshot, false if the file could not be written
+   static bool Dump(const F12020MetricsSnapshot& snapshot, const char* path);
+
+private:
+   struct State;
+   State* m_state;
+};
+#else
+inline int64_t F12020MetricsNow() { return 0; }
+
+struct F12020Metrics
+{
+   void Record(F12020MetricStage, int64_t) {}
+   void RecordPacket(unsigned, int64_t) {}
+   void Count(F12020MetricCounter, uint64_t = 1) {}
+   void Snapshot(F12020MetricsSnapshot& snapshot) const { snapshot = F12020MetricsSnapshot{}; }
+   void Reset() {}
+   static bool Dump(const F12020MetricsSnapshot&, const char*) { return false; }
+};
+#endif
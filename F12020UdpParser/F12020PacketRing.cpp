@@ -0,0 +1,131 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+// compiled without /clr, see F12020UdpParser.vcxproj
+
+#include "F12020PacketRing.h"
+
+#include <atomic>
+#include <memory>
+#include <string.h>
+
+struct F12020PacketRing::State
+{
+   explicit State(unsigned capacity)
+      : mask(capacity - 1)
+      , slots(new uint8_t[static_cast<size_t>(capacity) * F12020_RING_SLOT_SIZE])
+      , lens(new unsigned[capacity])
+   {
+   }
+
+   const unsigned mask;
+   std::unique_ptr<uint8_t[]> slots;
+   std::unique_ptr<unsigned[]> lens;
+
+   // separate cache lines for producer and consumer side
+   alignas(64) std::atomic<uint32_t> head{ 0 }; // next slot to write, owned by the producer
+   std::atomic<uint64_t> pushed{ 0 };
+   std::atomic<uint64_t> dropped{ 0 };
+   std::atomic<uint64_t> oversized{ 0 };
+   std::atomic<unsigned> highWater{ 0 };
+
+   alignas(64) std::atomic<uint32_t> tail{ 0 }; // next slot to read, owned by the consumer
+   std::atomic<uint64_t> popped{ 0 };
+
+   uint8_t* Slot(uint32_t idx) const { return slots.get() + static_cast<size_t>(idx & mask) * F12020_RING_SLOT_SIZE; }
+};
+
+F12020PacketRing::F12020PacketRing(unsigned slots)
+{
+   unsigned capacity = 1;
+   while (capacity < slots)
+      capacity <<= 1;
+
+   m_state = new State(capacity);
+}
+
+F12020PacketRing::~F12020PacketRing()
+{
+   delete m_state;
+}
+
+uint8_t* F12020PacketRing::BeginWrite()
+{
+   const uint32_t head = m_state->head.load(std::memory_order_relaxed);
+   const uint32_t tail = m_state->tail.load(std::memory_order_acquire);
+   if ((head - tail) > m_state->mask)
+   {
+      m_state->dropped.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+   }
+
+   return m_state->Slot(head);
+}
+
+void F12020PacketRing::CommitWrite(unsigned len)
+{
+   if (len > F12020_RING_SLOT_SIZE)
+   {
+      m_state->oversized.fetch_add(1, std::memory_order_relaxed);
+      return;
+   }
+
+   const uint32_t head = m_state->head.load(std::memory_order_relaxed);
+   m_state->lens[head & m_state->mask] = len;
+   m_state->head.store(head + 1, std::memory_order_release);
+   m_state->pushed.fetch_add(1, std::memory_order_relaxed);
+
+   const unsigned queued = head + 1 - m_state->tail.load(std::memory_order_relaxed);
+   if (queued > m_state->highWater.load(std::memory_order_relaxed))
+      m_state->highWater.store(queued, std::memory_order_relaxed);
+}
+
+bool F12020PacketRing::Push(const uint8_t* pData, unsigned len)
+{
+   if (len > F12020_RING_SLOT_SIZE)
+   {
+      m_state->oversized.fetch_add(1, std::memory_order_relaxed);
+      return false;
+   }
+
+   uint8_t* slot = BeginWrite();
+   if (!slot)
+      return false;
+
+   memcpy(slot, pData, len);
+   CommitWrite(len);
+   return true;
+}
+
+const uint8_t* F12020PacketRing::Front(unsigned& len) const
+{
+   const uint32_t tail = m_state->tail.load(std::memory_order_relaxed);
+   const uint32_t head = m_state->head.load(std::memory_order_acquire);
+   if (head == tail)
+      return nullptr;
+
+   len = m_state->lens[tail & m_state->mask];
+   return m_state->Slot(tail);
+}
+
+void F12020PacketRing::Pop()
+{
+   const uint32_t tail = m_state->tail.load(std::memory_order_relaxed);
+   if (tail == m_state->head.load(std::memory_order_acquire))
+      return;
+
+   m_state->tail.store(tail + 1, std::memory_order_release);
+   m_state->popped.fetch_add(1, std::memory_order_relaxed);
+}
+
+F12020PacketRingStats F12020PacketRing::Stats() const
+{
+   F12020PacketRingStats stats;
+   stats.pushed = m_state->pushed.load(std::memory_order_relaxed);
+   stats.popped = m_state->popped.load(std::memory_order_relaxed);
+   stats.dropped = m_state->dropped.load(std::memory_order_relaxed);
+   stats.oversized = m_state->oversized.load(std::memory_order_relaxed);
+   stats.highWater = m_state->highWater.load(std::memory_order_relaxed);
+   stats.capacity = m_state->mask + 1;
+   return stats;
+}
@@ -0,0 +1,47 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+#include <stdint.h>
+
+// Fixed capacity single producer / single consumer ring of preallocated packet slots.
+// The receive thread writes each datagram into a free slot, the parser consumes the slots in place,
+// so no memory is allocated per packet. If the consumer falls behind, new packets are dropped and counted.
+// The implementation is native only (<atomic> is not available with /clr), the header is safe for managed code.
+
+constexpr unsigned F12020_RING_SLOT_SIZE = 2048; // largest F1 2020 packet is 1464 bytes
+constexpr unsigned F12020_RING_DEFAULT_SLOTS = 256;
+
+struct F12020PacketRingStats
+{
+   uint64_t pushed;    // packets written
+   uint64_t popped;    // packets consumed
+   uint64_t dropped;   // packets lost because the ring was full
+   uint64_t oversized; // packets lost because they exceed F12020_RING_SLOT_SIZE
+   unsigned highWater; // maximum number of queued packets seen
+   unsigned capacity;
+};
+
+struct F12020PacketRing
+{
+   explicit F12020PacketRing(unsigned slots = F12020_RING_DEFAULT_SLOTS); // rounded up to a power of 2
+   ~F12020PacketRing();
+   F12020PacketRing(const F12020PacketRing&) = delete;
+   F12020PacketRing& operator=(const F12020PacketRing&) = delete;
+
+   // producer: BeginWrite returns a free slot of F12020_RING_SLOT_SIZE bytes (nullptr and counted as drop if full),
+   // CommitWrite publishes it with the number of bytes written.
+   uint8_t* BeginWrite();
+   void CommitWrite(unsigned len);
+   bool Push(const uint8_t* pData, unsigned len); // copy into a slot, false if dropped
+
+   // consumer: Front returns the oldest packet (nullptr if empty), which stays valid until Pop()
+   const uint8_t* Front(unsigned& len) const;
+   void Pop();
+
+   F12020PacketRingStats Stats() const; // may be called from any thread
+
+private:
+   struct State;
+   State* m_state;
+};
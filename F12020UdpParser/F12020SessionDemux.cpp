@@ -0,0 +1,300 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+// compiled without /clr, see F12020UdpParser.vcxproj
+
+#include "F12020SessionDemux.h"
+#include "F12020PacketRing.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string.h>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+   constexpr unsigned WORKER_SLOTS = 1024;
+   constexpr unsigned SOURCE_PREFIX = sizeof(uint64_t); // each ring slot starts with the sender, then the packet
+   constexpr int64_t SWEEP_INTERVAL_NS = 1000000000;     // idle sessions are looked for at most this often
+
+   int64_t Now()
+   {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+   }
+
+   uint64_t Mix(uint64_t x)
+   {
+      // splitmix64 finalizer
+      x ^= x >> 30;
+      x *= 0xbf58476d1ce4e5b9ull;
+      x ^= x >> 27;
+      x *= 0x94d049bb133111ebull;
+      x ^= x >> 31;
+      return x;
+   }
+
+   struct KeyHash
+   {
+      size_t operator()(const F12020SessionKey& key) const
+      {
+         return static_cast<size_t>(Mix(key.sessionUID ^ Mix(key.source)));
+      }
+   };
+
+   struct Session
+   {
+      std::unique_ptr<F12020SessionEngine> engine;
+      int64_t lastNs; // time of the last packet
+   };
+
+   struct Worker
+   {
+      F12020PacketRing ring{ WORKER_SLOTS };
+      std::thread thread;
+      std::mutex mutex;
+      std::condition_variable wake;
+      std::atomic<bool> idle{ false };
+      std::unordered_map<F12020SessionKey, Session, KeyHash> sessions; // owned by the worker thread
+      int64_t nextSweep{ 0 };
+   };
+}
+
+struct F12020SessionDemux::State
+{
+   Observer observer;
+   int64_t idleTimeoutNs;
+   int64_t endLingerNs;
+   int64_t sweepIntervalNs;
+   std::vector<std::unique_ptr<Worker>> workers;
+   std::atomic<bool> stop{ false };
+   std::atomic<uint64_t> dispatched{ 0 };
+   std::atomic<uint64_t> rejected{ 0 };
+   std::atomic<uint64_t> processed{ 0 };
+   std::atomic<unsigned> sessions{ 0 };
+   std::atomic<uint64_t> evictedIdle{ 0 };
+   std::atomic<uint64_t> evictedEnded{ 0 };
+
+   void Run(Worker& worker);
+   void Proceed(Worker& worker, const uint8_t* slot, unsigned len, int64_t now);
+   bool FramePending(const Worker& worker) const;
+   void FlushFrames(Worker& worker); // derive the open frames, e.g. after the timeout for lost packets
+   void Evict(Worker& worker, int64_t now); // the sessions which ended or are idle
+   void Finish(const F12020SessionKey& key, F12020SessionEngine& engine); // derive the open frame, final observer call
+};
+
+void F12020SessionDemux::State::Run(Worker& worker)
+{
+   for (;;)
+   {
+      unsigned len;
+      int64_t now = Now(); // once per batch, precise enough for the idle timeout
+      while (const uint8_t* slot = worker.ring.Front(len))
+      {
+         Proceed(worker, slot, len, now);
+         worker.ring.Pop();
+      }
+
+      if (stop.load())
+      {
+         if (!worker.ring.Front(len))
+         {
+            for (auto& session : worker.sessions)
+               Finish(session.first, *session.second.engine);
+            return;
+         }
+         continue;
+      }
+
+      if (now >= worker.nextSweep)
+         Evict(worker, now);
+
+      // sleep until the ingest queues a packet, idle is read by Dispatch after queuing.
+      // With a frame open, wake up after the frame timeout to derive it anyway, with sessions for the next sweep.
+      const bool pending = FramePending(worker);
+      bool timeout = false;
+      {
+         std::unique_lock<std::mutex> lock(worker.mutex);
+         worker.idle.store(true);
+         std::atomic_thread_fence(std::memory_order_seq_cst);
+         auto ready = [&]() { unsigned l; return worker.ring.Front(l) || stop.load(); };
+         if (pending)
+            timeout = !worker.wake.wait_for(lock, std::chrono::nanoseconds(F12020_FRAME_TIMEOUT_NS), ready);
+         else if (!worker.sessions.empty())
+            worker.wake.wait_for(lock, std::chrono::nanoseconds(worker.nextSweep - now), ready);
+         else
+            worker.wake.wait(lock, ready);
+         worker.idle.store(false);
+      }
+
+      if (timeout)
+         FlushFrames(worker);
+   }
+}
+
+bool F12020SessionDemux::State::FramePending(const Worker& worker) const
+{
+   for (const auto& session : worker.sessions)
+   {
+      if (session.second.engine->FramePending())
+         return true;
+   }
+   return false;
+}
+
+void F12020SessionDemux::State::FlushFrames(Worker& worker)
+{
+   for (auto& session : worker.sessions)
+   {
+      F12020SessionEngine& engine = *session.second.engine;
+      if (!engine.FramePending())
+         continue;
+
+      engine.FlushFrame();
+      if (observer)
+         observer(session.first, engine, false);
+   }
+}
+
+void F12020SessionDemux::State::Evict(Worker& worker, int64_t now)
+{
+   for (auto it = worker.sessions.begin(); it != worker.sessions.end();)
+   {
+      F12020SessionEngine& engine = *it->second.engine;
+      const bool ended = engine.session.sessionFinished;
+      if (now - it->second.lastNs < (ended ? endLingerNs : idleTimeoutNs))
+      {
+         ++it;
+         continue;
+      }
+
+      Finish(it->first, engine);
+      (ended ? evictedEnded : evictedIdle).fetch_add(1, std::memory_order_relaxed);
+      sessions.fetch_sub(1, std::memory_order_relaxed);
+      it = worker.sessions.erase(it);
+   }
+   worker.nextSweep = now + sweepIntervalNs;
+}
+
+void F12020SessionDemux::State::Finish(const F12020SessionKey& key, F12020SessionEngine& engine)
+{
+   if (engine.FramePending())
+      engine.FlushFrame();
+   if (observer)
+      observer(key, engine, true);
+}
+
+void F12020SessionDemux::State::Proceed(Worker& worker, const uint8_t* slot, unsigned len, int64_t now)
+{
+   const uint8_t* packet = slot + SOURCE_PREFIX;
+   const auto& header = *reinterpret_cast<const PacketHeader*>(packet);
+
+   F12020SessionKey key;
+   key.sessionUID = header.m_sessionUID;
+   memcpy(&key.source, slot, sizeof(key.source));
+
+   Session& session = worker.sessions[key];
+   if (!session.engine)
+   {
+      session.engine.reset(new F12020SessionEngine());
+      sessions.fetch_add(1, std::memory_order_relaxed);
+   }
+   session.lastNs = now;
+
+   F12020SessionEngine& engine = *session.engine;
+   const uint32_t frames = engine.frames;
+   engine.ProceedPacket(packet, len - SOURCE_PREFIX);
+   processed.fetch_add(1, std::memory_order_relaxed);
+
+   if (observer && (engine.frames != frames))
+      observer(key, engine, false);
+}
+
+F12020SessionDemux::F12020SessionDemux(const Observer& observer, unsigned workers, int64_t idleTimeoutNs)
+{
+   m_state = new State();
+   m_state->observer = observer;
+   m_state->idleTimeoutNs = idleTimeoutNs;
+   m_state->endLingerNs = std::min(F12020_SESSION_END_LINGER_NS, idleTimeoutNs);
+   m_state->sweepIntervalNs = std::max<int64_t>(std::min(SWEEP_INTERVAL_NS, m_state->endLingerNs / 2), 1);
+
+   if (!workers)
+      workers = std::thread::hardware_concurrency();
+   if (!workers)
+      workers = 1;
+
+   for (unsigned i = 0; i < workers; ++i)
+      m_state->workers.emplace_back(new Worker());
+
+   for (auto& worker : m_state->workers)
+   {
+      Worker* w = worker.get();
+      w->thread = std::thread([this, w]() { m_state->Run(*w); });
+   }
+}
+
+F12020SessionDemux::~F12020SessionDemux()
+{
+   m_state->stop.store(true);
+   for (auto& worker : m_state->workers)
+   {
+      {
+         std::lock_guard<std::mutex> lock(worker->mutex);
+         worker->wake.notify_one();
+      }
+      worker->thread.join();
+   }
+
+   delete m_state;
+}
+
+bool F12020SessionDemux::Dispatch(const uint8_t* pData, unsigned len, uint64_t source)
+{
+   F12020PacketView view = F12020ElementaryParser::Inspect(pData, len);
+   if (!view)
+   {
+      m_state->rejected.fetch_add(1, std::memory_order_relaxed);
+      return false;
+   }
+
+   F12020SessionKey key{ view.header->m_sessionUID, source };
+   Worker& worker = *m_state->workers[KeyHash()(key) % m_state->workers.size()];
+
+   uint8_t* slot = worker.ring.BeginWrite();
+   if (!slot)
+      return false; // counted by the ring
+
+   memcpy(slot, &source, SOURCE_PREFIX);
+   memcpy(slot + SOURCE_PREFIX, view.data, view.len);
+   worker.ring.CommitWrite(SOURCE_PREFIX + view.len);
+   m_state->dispatched.fetch_add(1, std::memory_order_relaxed);
+
+   // the store to the ring must be visible before idle is read, see State::Run
+   std::atomic_thread_fence(std::memory_order_seq_cst);
+   if (worker.idle.load())
+   {
+      std::lock_guard<std::mutex> lock(worker.mutex);
+      worker.wake.notify_one();
+   }
+   return true;
+}
+
+F12020SessionDemuxStats F12020SessionDemux::Stats() const
+{
+   F12020SessionDemuxStats stats{};
+   stats.dispatched = m_state->dispatched.load(std::memory_order_relaxed);
+   stats.rejected = m_state->rejected.load(std::memory_order_relaxed);
+   stats.processed = m_state->processed.load(std::memory_order_relaxed);
+   stats.sessions = m_state->sessions.load(std::memory_order_relaxed);
+   stats.evictedIdle = m_state->evictedIdle.load(std::memory_order_relaxed);
+   stats.evictedEnded = m_state->evictedEnded.load(std::memory_order_relaxed);
+   stats.workers = static_cast<unsigned>(m_state->workers.size());
+   for (auto& worker : m_state->workers)
+      stats.dropped += worker->ring.Stats().dropped;
+   return stats;
+}
@@ -0,0 +1,62 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+#include <stdint.h>
+#include <functional>
+#include "F12020SessionEngine.h"
+
+// Routes the packets of many game instances to independent session engines.
+// A session is identified by PacketHeader::m_sessionUID and the sender address, so two rigs never share state.
+// Sessions are sharded over worker threads (by key), each worker owns its engines and is fed by its own
+// F12020PacketRing, so the ingest thread never blocks and throughput scales with the number of cores.
+// Every game session has a new UID, so the engines are evicted: after the idle timeout without packets, or
+// F12020_SESSION_END_LINGER_NS after the last packet once the session sent its end event (SEND), which leaves
+// time for the packets the game still sends afterwards. The open frame is derived and observed before.
+// The implementation is native only (<thread> is not available with /clr).
+
+constexpr int64_t F12020_SESSION_IDLE_TIMEOUT_NS = 600ll * 1000000000; // longer than any pause of a game
+constexpr int64_t F12020_SESSION_END_LINGER_NS = 10ll * 1000000000;
+
+struct F12020SessionKey
+{
+   uint64_t sessionUID;
+   uint64_t source; // sender address as delivered by the ingest, 0 if unknown
+
+   bool operator==(const F12020SessionKey& other) const { return (sessionUID == other.sessionUID) && (source == other.source); }
+};
+
+struct F12020SessionDemuxStats
+{
+   uint64_t dispatched; // packets queued to a worker
+   uint64_t rejected;   // packets not passing F12020ElementaryParser::Inspect
+   uint64_t dropped;    // packets lost because a worker queue was full
+   uint64_t processed;  // packets parsed by the workers
+   unsigned sessions;   // live now
+   uint64_t evictedIdle;  // sessions evicted after the idle timeout
+   uint64_t evictedEnded; // sessions evicted after their end event
+   unsigned workers;
+};
+
+struct F12020SessionDemux
+{
+   // called on the worker thread after each derived frame of a session (see F12020SessionEngine::ProceedPacket)
+   // and with final set once more when the session is evicted or the demux stops, with the complete state.
+   // The engine must not be kept beyond the call.
+   typedef std::function<void(const F12020SessionKey& key, const F12020SessionEngine& engine, bool final)> Observer;
+
+   // workers = 0: one per hardware thread. The end linger is at most the idle timeout.
+   explicit F12020SessionDemux(const Observer& observer, unsigned workers = 0, int64_t idleTimeoutNs = F12020_SESSION_IDLE_TIMEOUT_NS);
+   ~F12020SessionDemux(); // processes the queued packets, then stops the workers
+   F12020SessionDemux(const F12020SessionDemux&) = delete;
+   F12020SessionDemux& operator=(const F12020SessionDemux&) = delete;
+
+   // queue one datagram for its session, must always be called from the same (ingest) thread
+   bool Dispatch(const uint8_t* pData, unsigned len, uint64_t source = 0);
+
+   F12020SessionDemuxStats Stats() const; // may be called from any thread
+
+private:
+   struct State;
+   State* m_state;
+};
@@ -0,0 +1,878 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "F12020SessionEngine.h"
+
+#include <algorithm>
+#include <string.h>
+
+namespace
+{
+   // The derived state is split by the packet ids it is computed from, each part is only updated
+   // when one of them arrives (motion, setups and telemetry update no derived state at all).
+   constexpr uint32_t PACKET(int packetId) { return 1u << packetId; }
+
+   constexpr uint32_t DEPENDS_EVENT = PACKET(3);
+   constexpr uint32_t DEPENDS_SESSION = PACKET(1) | PACKET(4);         // session info and number of cars
+   constexpr uint32_t DEPENDS_LAPS = PACKET(2);                        // lap times, positions, sector crossings
+   constexpr uint32_t DEPENDS_PRESENCE = PACKET(2) | PACKET(4);        // result status of the participating cars
+   constexpr uint32_t DEPENDS_DELTAS = PACKET(1) | PACKET(2);          // player, leader, deltas (session type selects the kind)
+   constexpr uint32_t DEPENDS_CAR_STATUS = PACKET(2) | PACKET(4) | PACKET(7); // status, pit stops, tyres, team
+   constexpr uint32_t DEPENDS_CLASSIFICATION = PACKET(8);
+   constexpr uint32_t DEPENDS_GAPS = PACKET(2);
+
+   // sent for every simulation frame: motion (unless unsubscribed), lap, telemetry, status
+   constexpr uint32_t FRAME_PACKETS = PACKET(0) | PACKET(2) | PACKET(6) | PACKET(7);
+
+   // for training or Q1-Q3 use bestlap delta
+   bool QualifyingDelta(int sessionType)
+   {
+      switch (sessionType)
+      {
+      case 1: // P1
+      case 2: // P2
+      case 3: // P3
+      case 4: // Short P
+      case 5: // Q1
+      case 6: // Q2
+      case 7: // Q3
+      case 8: // Short Q
+         return true;
+      default:
+         return false;
+      }
+   }
+
+   // race times of both cars at the latest sector crossing they both have (usually the first candidate), false if none
+   bool LatestCommonCrossing(const F12020LapHistory& laps, const F12020DriverState* drivers, int a, int b, float& timeA, float& timeB)
+   {
+      return laps.LatestCommonCrossing(a, b, std::min(drivers[a].lastCrossing, drivers[b].lastCrossing), timeA, timeB);
+   }
+}
+
+F12020SessionEngine::F12020SessionEngine()
+{
+   parser.zeroCopy = true;
+   parser.subscriptions = F12020_ENGINE_PACKETS;
+   events.reserve(F12020_MAX_EVENTS); // never reallocated, appending takes no allocation
+}
+
+unsigned F12020SessionEngine::ProceedPacket(const uint8_t* pData, unsigned len)
+{
+   // a packet of the next frame closes the open one, derive it before the parser replaces the retained packets.
+   // Only a packet the parser takes counts, a rejected or unsubscribed datagram must not tear the frame.
+   if (m_pending)
+   {
+      F12020PacketView next = F12020ElementaryParser::Inspect(pData, len);
+      if (next && (parser.subscriptions & F12020PacketBit(next.header->m_packetId)) &&
+         ((next.header->m_frameIdentifier != m_frame) || (next.header->m_sessionUID != m_frameSession)))
+      {
+         m_frameExpected |= m_frameInputs;
+         FlushFrame();
+      }
+   }
+
+   unsigned processed = parser.ProceedPacket(pData, len);
+   if (!parser.lastPacket)
+      return processed;
+
+   const PacketHeader& header = *parser.lastPacket.header;
+   const uint32_t packet = PACKET(header.m_packetId);
+   m_sessionTime = header.m_sessionTime;
+   m_frame = header.m_frameIdentifier;
+   m_frameSession = header.m_sessionUID;
+   m_Scatter();
+
+   if (packet & DEPENDS_EVENT)
+   {
+      m_UpdateEvent(); // the parser keeps the last event only
+      return processed;
+   }
+
+   m_pending |= packet;
+   m_frameInputs |= packet & FRAME_PACKETS;
+   if (m_frameExpected && ((m_frameInputs & m_frameExpected) == m_frameExpected))
+      FlushFrame();
+   return processed;
+}
+
+void F12020SessionEngine::FlushFrame()
+{
+   if (!m_pending)
+      return;
+
+   m_Update();
+   m_frameInputs = 0;
+   ++frames;
+}
+
+void F12020SessionEngine::Clear()
+{
+   session.sessionFinished = false;
+   session.currentLap = 1;
+   session.countDrivers = 0;
+   events.clear();
+   eventsDropped = 0;
+   classifiedCars = 0;
+   parser.classification.m_numCars = 0;
+
+   for (auto& car : drivers)
+      car = F12020DriverState{};
+   laps.Clear();
+   gaps = F12020GapMatrix{};
+   cars = F12020CarStateStore{};
+
+   m_pending = ~0u; // everything derived from the retained packets again
+   m_frameExpected = 0;
+   ++generation;
+}
+
+namespace
+{
+   constexpr uint32_t STATE_VERSION = 3;
+
+   // layout check, a state is only valid for the same struct layout
+   struct StateHeader
+   {
+      uint32_t version;
+      uint32_t driverSize;
+      uint32_t carsSize;
+      uint32_t eventSize;
+      uint32_t events;
+   };
+
+   template<typename T>
+   void Append(std::vector<uint8_t>& state, const T& value)
+   {
+      const uint8_t* p = reinterpret_cast<const uint8_t*>(&value);
+      state.insert(state.end(), p, p + sizeof(value));
+   }
+
+   template<typename T>
+   bool Extract(const uint8_t*& pState, const uint8_t* pEnd, T& value)
+   {
+      if (static_cast<size_t>(pEnd - pState) < sizeof(value))
+         return false;
+      memcpy(&value, pState, sizeof(value));
+      pState += sizeof(value);
+      return true;
+   }
+}
+
+void F12020SessionEngine::SaveState(std::vector<uint8_t>& state) const
+{
+   StateHeader header{ STATE_VERSION, sizeof(F12020DriverState), sizeof(F12020CarStateStore), sizeof(F12020SessionEvent), static_cast<uint32_t>(events.size()) };
+
+   state.clear();
+   Append(state, header);
+   Append(state, session);
+   Append(state, drivers);
+   Append(state, cars);
+   Append(state, classifiedCars);
+   Append(state, classification);
+   Append(state, generation);
+   Append(state, gaps);
+   Append(state, m_sessionTime);
+   Append(state, m_pending);
+   Append(state, m_frameSession);
+   Append(state, m_frame);
+   Append(state, m_frameInputs);
+   Append(state, m_frameExpected);
+
+   // the packets the update reads beyond the current one (zero copy mode, see F12020ElementaryParser::m_CopyConsumed)
+   Append(state, parser.session);
+   Append(state, parser.lap);
+   Append(state, parser.event);
+   Append(state, parser.participants);
+   Append(state, parser.classification);
+
+   const uint8_t* p = reinterpret_cast<const uint8_t*>(events.data());
+   state.insert(state.end(), p, p + events.size() * sizeof(F12020SessionEvent));
+   laps.Save(state); // variable size, last
+}
+
+bool F12020SessionEngine::RestoreState(const uint8_t* pState, unsigned len)
+{
+   const uint8_t* pEnd = pState + len;
+
+   StateHeader header;
+   if (!Extract(pState, pEnd, header) || (header.version != STATE_VERSION) || (header.driverSize != sizeof(F12020DriverState)) ||
+      (header.carsSize != sizeof(F12020CarStateStore)) || (header.eventSize != sizeof(F12020SessionEvent)) || (header.events > F12020_MAX_EVENTS))
+      return false;
+
+   const size_t expected = sizeof(session) + sizeof(drivers) + sizeof(cars) + sizeof(classifiedCars) + sizeof(classification) +
+      sizeof(generation) + sizeof(gaps) + sizeof(m_sessionTime) + sizeof(m_pending) + sizeof(m_frameSession) + sizeof(m_frame) +
+      sizeof(m_frameInputs) + sizeof(m_frameExpected) + sizeof(parser.session) + sizeof(parser.lap) + sizeof(parser.event) +
+      sizeof(parser.participants) + sizeof(parser.classification) + header.events * sizeof(F12020SessionEvent);
+   if (static_cast<size_t>(pEnd - pState) < expected)
+      return false;
+
+   Extract(pState, pEnd, session);
+   Extract(pState, pEnd, drivers);
+   Extract(pState, pEnd, cars);
+   Extract(pState, pEnd, classifiedCars);
+   Extract(pState, pEnd, classification);
+   Extract(pState, pEnd, generation);
+   Extract(pState, pEnd, gaps);
+   Extract(pState, pEnd, m_sessionTime);
+   Extract(pState, pEnd, m_pending);
+   Extract(pState, pEnd, m_frameSession);
+   Extract(pState, pEnd, m_frame);
+   Extract(pState, pEnd, m_frameInputs);
+   Extract(pState, pEnd, m_frameExpected);
+   Extract(pState, pEnd, parser.session);
+   Extract(pState, pEnd, parser.lap);
+   Extract(pState, pEnd, parser.event);
+   Extract(pState, pEnd, parser.participants);
+   Extract(pState, pEnd, parser.classification);
+
+   events.resize(header.events);
+   if (header.events)
+      memcpy(events.data(), pState, header.events * sizeof(F12020SessionEvent));
+   if (!laps.Restore(pState + header.events * sizeof(F12020SessionEvent), pEnd))
+      return false;
+
+   parser.Restored();
+   return true;
+}
+
+void F12020SessionEngine::m_Scatter()
+{
+   // decode straight from the packet buffer, the parser does not copy telemetry and status in zero copy mode
+   const F12020PacketView& view = parser.lastPacket;
+   switch (view.header->m_packetId)
+   {
+   case 2: cars.ScatterLap(view.As<PacketLapData>()); break;
+   case 4: cars.ScatterParticipants(view.As<PacketParticipantsData>()); break;
+   case 6: cars.ScatterTelemetry(view.As<PacketCarTelemetryData>()); break;
+   case 7:
+      cars.ScatterStatus(view.As<PacketCarStatusData>());
+      cars.UpdateDamage();
+      break;
+   }
+}
+
+void F12020SessionEngine::m_Update()
+{
+   const uint32_t inputs = m_pending;
+   m_pending = 0;
+
+   if (inputs & DEPENDS_SESSION)
+      m_UpdateSession();
+   if (inputs & DEPENDS_LAPS)
+      m_UpdateLaps();
+   if (inputs & DEPENDS_PRESENCE)
+      m_UpdatePresence();
+   if (inputs & DEPENDS_DELTAS)
+      m_UpdateReferences();
+   if (inputs & (DEPENDS_CAR_STATUS | DEPENDS_DELTAS))
+      m_UpdateDrivers((inputs & DEPENDS_CAR_STATUS) != 0, (inputs & DEPENDS_DELTAS) != 0);
+
+   if (inputs & DEPENDS_CLASSIFICATION)
+      m_UpdateClassification();
+
+   if (inputs & DEPENDS_GAPS)
+      m_UpdateGaps();
+}
+
+void F12020SessionEngine::m_UpdateEvent()
+{
+   const PacketEventData& packet = parser.event;
+   const EventDataDetails& details = packet.m_eventDetails;
+   F12020SessionEvent e{};
+   e.sessionTime = m_sessionTime;
+
+   const uint32_t key = F12020EventKey(packet);
+   parser.event.m_eventStringCode[0] = 0; // inhibit another parse of the same event
+
+   switch (key)
+   {
+   case F12020_EVENT_SESSION_STARTED:
+      Clear();
+      e.type = F12020EventType::SessionStarted;
+      break;
+
+   case F12020_EVENT_SESSION_ENDED:
+      e.type = F12020EventType::SessionEnded;
+      session.sessionFinished = true;
+      break;
+
+   case F12020_EVENT_FASTEST_LAP:
+      e.type = F12020EventType::FastestLap;
+      e.carIndex = details.FastestLap.vehicleIdx;
+      e.lapTime = details.FastestLap.lapTime;
+      break;
+
+   case F12020_EVENT_RETIREMENT:
+      e.type = F12020EventType::Retirement;
+      e.carIndex = details.Retirement.vehicleIdx;
+      break;
+
+   case F12020_EVENT_DRS_ENABLED:
+      e.type = F12020EventType::DRSenabled;
+      break;
+
+   case F12020_EVENT_DRS_DISABLED:
+      e.type = F12020EventType::DRSdisabled;
+      break;
+
+   case F12020_EVENT_TEAM_MATE_IN_PITS:
+      e.type = F12020EventType::TeamMateInPits;
+      e.carIndex = details.TeamMateInPits.vehicleIdx;
+      break;
+
+   case F12020_EVENT_CHEQUERED_FLAG:
+      e.type = F12020EventType::ChequeredFlag;
+      break;
+
+   case F12020_EVENT_RACE_WINNER:
+      e.type = F12020EventType::RaceWinner;
+      e.carIndex = details.RaceWinner.vehicleIdx;
+      break;
+
+   case F12020_EVENT_PENALTY_ISSUED:
+      e.type = F12020EventType::PenaltyIssued;
+      e.penaltyType = details.Penalty.penaltyType;
+      e.infringementType = details.Penalty.infringementType;
+      e.carIndex = details.Penalty.vehicleIdx;
+      e.otherVehicleIdx = details.Penalty.otherVehicleIdx;
+      e.timeGained = details.Penalty.time;
+      e.lapNum = details.Penalty.lapNum;
+      e.placesGained = details.Penalty.placesGained;
+      e.penaltyServed = false;
+      break;
+
+   case F12020_EVENT_SPEED_TRAP:
+      e.type = F12020EventType::SpeedTrapTriggered;
+      e.carIndex = details.SpeedTrap.vehicleIdx;
+      e.speed = details.SpeedTrap.speed;
+      break;
+
+   default: // unknown or already consumed
+      return;
+   }
+
+   if (events.size() == F12020_MAX_EVENTS)
+   {
+      ++eventsDropped;
+      return;
+   }
+
+   events.push_back(e); // within the capacity reserved by the constructor
+   if (e.type == F12020EventType::PenaltyIssued)
+      m_AddPitPenalty(e);
+}
+
+void F12020SessionEngine::m_AddPitPenalty(const F12020SessionEvent& e)
+{
+   if (e.carIndex >= F12020_MAX_CARS)
+      return;
+
+   switch (e.penaltyType)
+   {
+   case F12020_PENALTY_DRIVE_THROUGH:
+   case F12020_PENALTY_STOP_GO:
+   case F12020_PENALTY_DISQUALIFIED:
+   case F12020_PENALTY_RETIRED:
+   {
+      auto& car = drivers[e.carIndex];
+      if (car.numPitPenalties < F12020_MAX_PIT_PENALTIES)
+         car.pitPenalties[car.numPitPenalties++] = static_cast<uint32_t>(events.size() - 1);
+      break;
+   }
+   }
+}
+
+void F12020SessionEngine::m_UpdateSession()
+{
+   // prevent left players to disappear in list
+   // which means during a session, the maximum number of players/ai ever present are shown.
+   if (parser.participants.m_numActiveCars > session.countDrivers)
+      session.countDrivers = std::min<int>(parser.participants.m_numActiveCars, F12020_MAX_CARS);
+
+   // Update Session
+   session.track = parser.session.m_trackId;
+   session.sessionType = parser.session.m_sessionType;
+   session.remainingTime = parser.session.m_sessionTimeLeft;
+   session.totalLaps = parser.session.m_totalLaps;
+}
+
+void F12020SessionEngine::m_UpdateLaps()
+{
+   for (int i = 0; i < F12020_MAX_CARS; ++i)
+   {
+      auto& car = drivers[i];
+      const int currentLapNum = cars.currentLapNum[i];
+
+      car.pos = cars.position[i];
+
+      unsigned lap_num = 0;
+      if (car.lapNr != currentLapNum) // Update last laptime
+      {
+         if (currentLapNum > static_cast<int>(lap_num))
+            lap_num = currentLapNum;
+
+         car.lapNr = currentLapNum;
+         car.tyreAge = car.lapNr - car.lapTiresFitted;
+         if (car.lapNr > 0) // should always be true
+         {
+            auto& currentLap = laps.At(i, car.lapNr);
+            currentLap.sector1 = 0;
+            currentLap.sector2 = 0;
+            currentLap.lap = 0;
+         }
+         if (car.lapNr > 1)
+         {
+            auto& lastLap = laps.At(i, car.lapNr - 1);
+            lastLap.lap = cars.lastLapTime[i];
+
+            if (car.lapNr == 2)
+               lastLap.lapsAccumulated = lastLap.lap;
+            else
+               lastLap.lapsAccumulated = lastLap.lap + laps.Lap(i, car.lapNr - 2).lapsAccumulated;
+
+            m_RecordCrossings(i, car.lapNr - 2);
+         }
+         if (car.lapNr > 0)
+            m_RecordCrossings(i, car.lapNr - 1);
+
+         m_RewindCrossings(i);
+      }
+
+      else if (car.lapNr > 0) // Update Sector1+2 if available
+      {
+         auto& currentLap = laps.At(i, car.lapNr);
+         bool crossed = false;
+         if (currentLap.sector1 == 0)
+         {
+            if (cars.sector[i] > 0)
+            {
+               currentLap.sector1 = cars.sector1TimeInMS[i] / 1000.0f;
+               crossed = true;
+            }
+         }
+
+         if (currentLap.sector2 == 0)
+         {
+            if (cars.sector[i] > 1)
+            {
+               currentLap.sector2 = cars.sector2TimeInMS[i] / 1000.0f;
+               crossed = true;
+            }
+         }
+
+         if (crossed)
+            m_RecordCrossings(i, car.lapNr - 1);
+      }
+
+      if (lap_num > static_cast<unsigned>(session.currentLap))
+      {
+         session.currentLap = std::min<int>(lap_num, session.totalLaps); // clamp to TotalLaps to prevent the post race lap to count behind maximum
+      }
+   }
+
+}
+
+void F12020SessionEngine::m_UpdatePresence()
+{
+   for (int i = 0; i < session.countDrivers; ++i)
+   {
+      switch (cars.resultStatus[i])
+      {
+         // According to doc:
+         // Result status - 0 = invalid, 1 = inactive, 2 = active
+         // 3 = finished, 4 = disqualified, 5 = not classified
+         // 6 = retired
+         // BUT: 7 seems to be a legit code for a dnf car!
+      case 2:
+      case 3:
+         drivers[i].present = true;
+         break;
+      default:
+         drivers[i].present = false;
+         drivers[i].timedeltaToPlayer = 0;
+         break;
+      }
+   }
+
+}
+
+void F12020SessionEngine::m_UpdateReferences()
+{
+   session.playerIdx = -1;
+   if (parser.lap.m_header.m_playerCarIndex < F12020_MAX_CARS) // in visitor modes index is 255
+      session.playerIdx = parser.lap.m_header.m_playerCarIndex;
+
+   // find leader (if available)
+   // car.present not required, the in qualy the car might be retired after setting lap which is still valid
+   session.leaderIdx = cars.FindLeader();
+   if (session.leaderIdx >= 0)
+      drivers[session.leaderIdx].timedeltaToLeader = 0;
+
+   // m_playerCarIndex defaults to 0 and might change when the first actual packet arrives
+   // which means we must check, if we declared first car 0 by accident as player and revert in that case!
+   if (parser.lap.m_header.m_playerCarIndex != 0)
+      drivers[0].isPlayer = false;
+}
+
+void F12020SessionEngine::m_UpdateDrivers(bool status, bool deltas)
+{
+   const bool qualyfiyingDelta = QualifyingDelta(session.sessionType);
+   const int player = session.playerIdx;
+   const int leader = session.leaderIdx;
+
+   if (player >= 0)
+   {
+      drivers[player].isPlayer = true;
+      drivers[player].timedeltaToPlayer = 0;
+
+      if (!drivers[player].lapNr)
+         return;
+   }
+
+   // status first, the qualifying deltas are based on the fastest laps
+   for (int i = 0; status && (i < F12020_MAX_CARS); ++i)
+   {
+      if (drivers[i].present)
+         m_UpdateCarStatus(i);
+   }
+
+   // update the delta Time
+   for (int i = 0; deltas && (i < F12020_MAX_CARS); ++i)
+   {
+      auto& car = drivers[i];
+      if (!car.present)
+         continue;
+
+      // delta to player
+      if (player >= 0)
+      {
+         if (!car.isPlayer)
+            qualyfiyingDelta ? m_UpdateTimeDeltaQualy(player, i, true) : m_UpdateTimeDeltaRace(player, i, true);
+      }
+      else
+      {
+         car.lastTimedeltaToPlayer = 0;
+         car.timedeltaToPlayer = 0;
+      }
+
+      // delta to leader
+      if ((leader >= 0) && (i != leader))
+         qualyfiyingDelta ? m_UpdateTimeDeltaQualy(leader, i, false) : m_UpdateTimeDeltaRace(leader, i, false);
+   }
+}
+
+void F12020SessionEngine::m_UpdateCarStatus(int i)
+{
+   auto& car = drivers[i];
+   car.fastestLap = cars.bestLapTime[i];
+   car.penaltySeconds = cars.penalties[i];
+   car.tyre = cars.actualTyreCompound[i];
+   car.visualTyre = cars.visualTyreCompound[i];
+   if (!car.numVisualTyres && car.visualTyre)
+   {
+      // add the first tyre at the start of race
+      m_AddVisualTyre(car);
+   }
+
+   // car.tyreAge = statusNative.m_tyresAgeLaps; -> NOOO its a lie! (Game telemetry has invalid data).
+
+   F12020DriverStatus oldDriverStatus = car.status;
+
+   switch (cars.resultStatus[i])
+   {
+      //0 = invalid, 1 = inactive, 2 = active
+      // 3 = finished, 4 = disqualified, 5 = not classified
+      // 6 = retired - apparently 7 also = retired
+   case 4:
+      car.status = F12020DriverStatus::DSQ;
+      break;
+
+   case 5:
+   case 6:
+   case 7:
+      car.status = F12020DriverStatus::DNF;
+      break;
+
+   default:
+      switch (cars.pitStatus[i])
+      {
+      case 1: car.status = F12020DriverStatus::Pitlane; break;
+      case 2: car.status = F12020DriverStatus::Pitting; car.hasPitted = true; break;
+
+      default:
+         switch (cars.driverStatus[i])
+         {
+            // Status of driver - 0 = in garage, 1 = flying lap
+            // 2 = in lap, 3 = out lap, 4 = on track
+         case 1:
+         case 2:
+         case 3:
+         case 4:
+            car.status = F12020DriverStatus::OnTrack; break;
+         default:
+            car.status = F12020DriverStatus::Garage; // just assume....
+            break;
+         }
+         break;
+      }
+      break;
+   }
+
+   m_UpdatePitStop(i, oldDriverStatus);
+
+   uint8_t teamId = cars.teamId[i];
+   car.team = (teamId < 10) ? teamId : 10; // 10 = classic
+}
+
+void F12020SessionEngine::m_UpdatePitStop(int i, F12020DriverStatus oldDriverStatus)
+{
+   auto& car = drivers[i];
+
+   if (oldDriverStatus == F12020DriverStatus::Pitting && car.status != oldDriverStatus)
+   {
+      // deduce the tyres were probably be changed (we don't get specific notification about that)
+      m_AddVisualTyre(car);
+   }
+
+   if (oldDriverStatus == F12020DriverStatus::Pitlane && (car.status == F12020DriverStatus::OnTrack))
+   {
+      if (!car.hasPitted)
+      {
+         // in pits without pitstop -> probably served drive through penalty
+         for (int j = 0; j < car.numPitPenalties; ++j)
+         {
+            auto& penalty = events[car.pitPenalties[j]];
+            if ((penalty.penaltyType == F12020_PENALTY_DRIVE_THROUGH) && (!penalty.penaltyServed))
+            {
+               penalty.penaltyServed = true;
+               break;
+            }
+         }
+      }
+      else
+      {
+         // car has pitted
+         car.lapTiresFitted = car.lapNr;
+         car.tyreAge = 0;
+
+         // also see if a penalty was served:
+         for (int j = 0; j < car.numPitPenalties; ++j)
+         {
+            auto& penalty = events[car.pitPenalties[j]];
+            if ((penalty.penaltyType != F12020_PENALTY_DRIVE_THROUGH) && (!penalty.penaltyServed))
+            {
+               if (penalty.infringementType == F12020_INFRINGEMENT_PIT_LANE_SPEEDING)
+               {
+                  // pit lane speeding can't be serverd immediately, check if it is old enough
+                  if ((m_sessionTime - penalty.sessionTime) > 60)
+                  {
+                     penalty.penaltyServed = true;
+                     break;
+                  }
+               }
+               else
+               {
+                  penalty.penaltyServed = true;
+                  break;
+               }
+            }
+         }
+      }
+      car.hasPitted = false;
+   }
+}
+
+void F12020SessionEngine::m_UpdateTimeDeltaRace(int reference, int i, bool toPlayer)
+{
+   auto& opponent = drivers[i];
+   if (!opponent.present)
+      return;
+
+   float timePlayer;
+   float timeOpponent;
+   if (!LatestCommonCrossing(laps, drivers, reference, i, timePlayer, timeOpponent))
+      return;
+
+   auto newDelta = timePlayer - timeOpponent;
+   if (toPlayer)
+   {
+      // take penalties into consideration
+      newDelta -= cars.penalties[i];
+
+      if (newDelta != opponent.timedeltaToPlayer)
+      {
+         opponent.lastTimedeltaToPlayer = opponent.timedeltaToPlayer;
+         opponent.timedeltaToPlayer = newDelta;
+      }
+   }
+   else
+   {
+      opponent.timedeltaToLeader = -newDelta;
+   }
+}
+
+void F12020SessionEngine::m_RecordCrossings(int i, int lapIdx)
+{
+   auto& car = drivers[i];
+   const F12020LapTimes lap = laps.Lap(i, lapIdx + 1);
+   const float start = (lapIdx > 0) ? laps.Lap(i, lapIdx).lapsAccumulated : 0;
+
+   float crossings[F12020_SECTORS];
+   crossings[0] = lap.sector1 ? start + lap.sector1 : 0;
+   crossings[1] = lap.sector2 ? start + (lap.sector1 + lap.sector2) : 0;
+   crossings[2] = lap.lap ? start + lap.lap : 0;
+   laps.SetCrossings(i, lapIdx + 1, crossings);
+
+   for (int n = lapIdx * F12020_SECTORS + F12020_SECTORS - 1; n > car.lastCrossing; --n)
+   {
+      if (laps.Crossing(i, n))
+      {
+         car.lastCrossing = n;
+         break;
+      }
+   }
+}
+
+void F12020SessionEngine::m_RewindCrossings(int i)
+{
+   // after a lap change the latest crossing is the finish of the previous lap (if recorded)
+   auto& car = drivers[i];
+   int n = std::min(car.lapNr, laps.StoredLaps(i)) * F12020_SECTORS - 1;
+   while ((n >= 0) && !laps.Crossing(i, n))
+      --n;
+
+   car.lastCrossing = n;
+}
+
+void F12020SessionEngine::m_UpdateGaps()
+{
+   const bool qualyfiyingDelta = QualifyingDelta(session.sessionType);
+
+   gaps.frame = parser.lap.m_header.m_frameIdentifier;
+   for (int a = 0; a < F12020_MAX_CARS; ++a)
+   {
+      gaps.valid[a] = 0;
+      gaps.gap[a][a] = 0;
+   }
+
+   for (int a = 0; a < session.countDrivers; ++a)
+   {
+      const auto& carA = drivers[a];
+      if (!carA.present)
+         continue;
+
+      gaps.valid[a] |= 1u << a;
+      for (int b = a + 1; b < session.countDrivers; ++b)
+      {
+         const auto& carB = drivers[b];
+         if (!carB.present)
+            continue;
+
+         float gap;
+         if (qualyfiyingDelta)
+         {
+            if (!carA.fastestLap || !carB.fastestLap)
+               continue;
+
+            gap = carB.fastestLap - carA.fastestLap;
+         }
+         else
+         {
+            float timeA;
+            float timeB;
+            if (!LatestCommonCrossing(laps, drivers, a, b, timeA, timeB))
+               continue;
+
+            gap = (timeB + cars.penalties[b]) - (timeA + cars.penalties[a]);
+         }
+
+         gaps.gap[a][b] = gap;
+         gaps.gap[b][a] = -gap;
+         gaps.valid[a] |= 1u << b;
+         gaps.valid[b] |= 1u << a;
+      }
+   }
+}
+
+int F12020SessionEngine::CarAt(int pos) const
+{
+   for (int i = 0; i < session.countDrivers; ++i)
+   {
+      if (drivers[i].present && (drivers[i].pos == pos))
+         return i;
+   }
+   return -1;
+}
+
+int F12020SessionEngine::CarAhead(int i) const
+{
+   return (drivers[i].pos > 1) ? CarAt(drivers[i].pos - 1) : -1;
+}
+
+int F12020SessionEngine::CarBehind(int i) const
+{
+   return drivers[i].pos ? CarAt(drivers[i].pos + 1) : -1;
+}
+
+int F12020SessionEngine::Teammate(int i) const
+{
+   for (int j = 0; j < session.countDrivers; ++j)
+   {
+      if ((j != i) && drivers[j].present && (cars.teamId[j] == cars.teamId[i]))
+         return j;
+   }
+   return -1;
+}
+
+bool F12020SessionEngine::Gap(int from, int to, float& gap) const
+{
+   if ((from < 0) || (to < 0) || !(gaps.valid[from] & (1u << to)))
+      return false;
+
+   gap = gaps.gap[from][to];
+   return true;
+}
+
+void F12020SessionEngine::m_UpdateTimeDeltaQualy(int reference, int i, bool toPlayer /* if false -> to leader */)
+{
+   auto& opponent = drivers[i];
+   if (!opponent.present)
+      return;
+
+   float newDelta = opponent.fastestLap - drivers[reference].fastestLap;
+
+   if (toPlayer)
+   {
+      if (newDelta != opponent.timedeltaToPlayer)
+      {
+         opponent.lastTimedeltaToPlayer = opponent.timedeltaToPlayer;
+         opponent.timedeltaToPlayer = newDelta;
+      }
+   }
+   else
+   {
+      opponent.timedeltaToLeader = newDelta;
+   }
+}
+
+void F12020SessionEngine::m_UpdateClassification()
+{
+   if (classifiedCars)
+      return;
+
+   if (!parser.classification.m_numCars)
+      return;
+
+   // classification available, apply:
+   classifiedCars = std::min<uint8_t>(parser.classification.m_numCars, F12020_MAX_CARS);
+   memcpy(classification, parser.classification.m_classificationData, sizeof(classification));
+
+   parser.classification.m_numCars = 0; // set a marker that classifcation results were captured.
+}
+
+void F12020SessionEngine::m_AddVisualTyre(F12020DriverState& car)
+{
+   if (car.numVisualTyres < F12020_MAX_STINTS)
+      car.visualTyres[car.numVisualTyres++] = car.visualTyre;
+}
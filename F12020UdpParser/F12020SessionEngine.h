@@ -0,0 +1,207 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include "F12020DataDefs.h"
+#include "F12020ElementaryParser.h"
+#include "F12020CarStateStore.h"
+#include "F12020LapHistory.h"
+
+// Native session state: the race logic without any managed types, so it can run headless.
+// F12020UdpClrMapper projects this state onto the CLR objects for the UI.
+
+constexpr int F12020_MAX_STINTS = 32;
+constexpr int F12020_MAX_PIT_PENALTIES = 16;
+constexpr unsigned F12020_MAX_EVENTS = 4096; // journaled events per session, far more than a full race with penalties
+constexpr int64_t F12020_FRAME_TIMEOUT_NS = 50000000; // receive time after which an incomplete frame is derived anyway
+
+// values match adjsw::F12020::DriverStatus
+enum class F12020DriverStatus : uint8_t
+{
+   Garage,
+   OnTrack,
+   Pitlane,
+   Pitting,
+   DNF,
+   DSQ
+};
+
+// values match adjsw::F12020::EventType
+enum class F12020EventType : uint8_t
+{
+   SessionStarted,
+   SessionEnded,
+   FastestLap,
+   Retirement,
+   DRSenabled,
+   DRSdisabled,
+   TeamMateInPits,
+   ChequeredFlag,
+   RaceWinner,
+   PenaltyIssued,
+   SpeedTrapTriggered
+};
+
+// values match adjsw::F12020::PenaltyTypes / InfringementTypes where used
+constexpr uint8_t F12020_PENALTY_DRIVE_THROUGH = 0;
+constexpr uint8_t F12020_PENALTY_STOP_GO = 1;
+constexpr uint8_t F12020_PENALTY_DISQUALIFIED = 6;
+constexpr uint8_t F12020_PENALTY_RETIRED = 16;
+constexpr uint8_t F12020_INFRINGEMENT_PIT_LANE_SPEEDING = 17;
+
+struct F12020SessionEvent
+{
+   F12020EventType type;
+   uint8_t carIndex;
+   float sessionTime; // session timestamp of the packet which carried the event
+
+   // penalty info
+   uint8_t penaltyType;
+   uint8_t infringementType;
+   uint8_t otherVehicleIdx;
+   uint8_t timeGained; // Time gained, or time spent doing action in seconds
+   uint8_t lapNum;
+   uint8_t placesGained;
+   bool penaltyServed; // not present in actual telemetry, deduced from race telemetry
+
+   float lapTime; // FastestLap: lap time in seconds
+   float speed;   // SpeedTrapTriggered: top speed in km/h
+};
+
+struct F12020DriverState
+{
+   bool present;
+   bool isPlayer;
+   F12020DriverStatus status;
+   uint8_t team;       // team id, 10 = classic
+   uint8_t tyre;       // actual compound
+   uint8_t visualTyre; // visual compound
+   int pos;
+   int lapNr{ 1 };
+   int tyreAge;
+   int penaltySeconds;
+   float fastestLap;
+   float timedeltaToPlayer;
+   float lastTimedeltaToPlayer;
+   float timedeltaToLeader;
+
+   // car detail (wear, temperatures, damage) is in F12020SessionEngine::cars
+
+   uint8_t visualTyres[F12020_MAX_STINTS]; // tyre history, the last one is the currently fitted
+   int numVisualTyres;
+   uint32_t pitPenalties[F12020_MAX_PIT_PENALTIES]; // index into F12020SessionEngine::events
+   int numPitPenalties;
+
+   int lapTiresFitted{ 1 }; // for tyre age, which is not directly available in non complete telemetry.
+   bool hasPitted;
+
+   // lap times and sector crossings are in F12020SessionEngine::laps
+   int lastCrossing{ -1 }; // latest recorded crossing within the current lap, see F12020LapHistory::Crossing
+};
+
+// gaps between all cars, refreshed with every lap data packet
+struct F12020GapMatrix
+{
+   // gap[a][b]: seconds car b is behind car a (negative if ahead), including time penalties.
+   // race: at the latest sector crossing of both cars, practice / qualifying: fastest lap difference
+   float gap[F12020_MAX_CARS][F12020_MAX_CARS];
+   uint32_t valid[F12020_MAX_CARS]; // bit b of valid[a] is set if gap[a][b] is known
+   uint32_t frame; // m_frameIdentifier of the lap data packet
+};
+
+struct F12020SessionState
+{
+   int track{ 17 }; // Austria
+   int sessionType{ 1 }; // P1
+   bool sessionFinished{ false };
+   uint8_t padding[3]{}; // defined bytes, SaveState writes the structure as is
+   int remainingTime{ 0 };
+   int totalLaps{ 2 };
+   int currentLap{ 1 };
+   int countDrivers{ 0 }; // the maximum number of cars ever present during the session
+   int playerIdx{ -1 };   // -1 in spectator mode
+   int leaderIdx{ -1 };
+};
+
+// the packets the derived state depends on, the default subscriptions of F12020SessionEngine::parser.
+// Motion and setups are never consumed and rejected after the header.
+constexpr uint32_t F12020_ENGINE_PACKETS = F12020_PACKETS_ALL & ~(F12020PacketBit(0) | F12020PacketBit(5));
+
+struct F12020SessionEngine
+{
+   F12020SessionEngine();
+
+   // parse one packet from pData and update the derived state, returns the number of bytes consumed.
+   // The packets of one simulation frame (PacketHeader::m_frameIdentifier) are derived together, so the state never mixes
+   // two frames: the update runs when the frame is complete (all per frame packet types seen before have arrived)
+   // or when the next frame starts. Events are applied immediately.
+   unsigned ProceedPacket(const uint8_t* pData, unsigned len);
+
+   // derive the open frame now, e.g. at the end of a replay or after F12020_FRAME_TIMEOUT_NS without packets (lost packets)
+   void FlushFrame();
+   bool FramePending() const { return m_pending != 0; }
+
+   // reset all derived state, done automatically when a new session starts
+   void Clear();
+
+   // serialize the complete state (derived state and the retained packets of the parser), e.g. for capture keyframes.
+   // RestoreState fails for states of another build (different layout).
+   void SaveState(std::vector<uint8_t>& state) const;
+   bool RestoreState(const uint8_t* pState, unsigned len);
+
+   F12020ElementaryParser parser;
+
+   F12020SessionState session;
+   F12020DriverState drivers[F12020_MAX_CARS]{};
+   F12020CarStateStore cars{}; // per car packet fields, scattered from every lap, participants, telemetry and status packet
+   F12020LapHistory laps;      // lap times and sector crossings of every car
+   std::vector<F12020SessionEvent> events; // journal of the events of the session, allocated once for F12020_MAX_EVENTS
+   uint32_t eventsDropped{ 0 };            // events beyond F12020_MAX_EVENTS, not journaled
+
+   uint8_t classifiedCars{ 0 }; // 0 if no classification available
+   FinalClassificationData classification[F12020_MAX_CARS]{};
+
+   uint32_t generation{ 0 }; // incremented on every Clear()
+   uint32_t frames{ 0 };     // incremented for every derived frame, i.e. when the state changed as a whole
+
+   F12020GapMatrix gaps{};
+
+   // gap lookups for the overlay, false / -1 if not available
+   bool Gap(int from, int to, float& gap) const;
+   int CarAt(int pos) const;
+   int CarAhead(int i) const;
+   int CarBehind(int i) const;
+   int Teammate(int i) const;
+
+private:
+   void m_Update();
+   void m_UpdateEvent();
+   void m_AddPitPenalty(const F12020SessionEvent& e);
+   void m_UpdateSession();
+   void m_UpdateLaps();
+   void m_UpdatePresence();
+   void m_UpdateReferences(); // player and leader
+   void m_UpdateDrivers(bool status, bool deltas);
+   void m_UpdateCarStatus(int i);
+   void m_UpdateTimeDeltaRace(int reference, int i, bool toPlayer /* if false -> to leader */);
+   void m_UpdateTimeDeltaQualy(int reference, int i, bool toPlayer /* if false -> to leader */);
+   void m_UpdateGaps();
+   void m_Scatter();
+   void m_UpdatePitStop(int i, F12020DriverStatus oldStatus);
+   void m_RecordCrossings(int i, int lapIdx);
+   void m_RewindCrossings(int i);
+   void m_UpdateClassification();
+
+   void m_AddVisualTyre(F12020DriverState& car);
+
+   float m_sessionTime{ 0 }; // session time of the last packet
+   uint32_t m_pending{ ~0u }; // packet ids (bit mask) of the open frame to update for, all after Clear()
+
+   // frame assembly
+   uint64_t m_frameSession{ 0 };
+   uint32_t m_frame{ 0 };       // m_frameIdentifier of the open frame
+   uint32_t m_frameInputs{ 0 }; // per frame packet ids received for the open frame
+   uint32_t m_frameExpected{ 0 }; // per frame packet ids the game sends, learned from the completed frames
+};
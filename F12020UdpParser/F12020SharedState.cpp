@@ -0,0 +1,371 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+// compiled without /clr, see F12020UdpParser.vcxproj
+
+#include "F12020SharedState.h"
+#include "F12020Capture.h"
+#include "F12020SessionEngine.h"
+
+#include <algorithm>
+#include <atomic>
+#include <string.h>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static_assert(F12020_SHARED_CARS == F12020_MAX_CARS, "one car record per car");
+static_assert((sizeof(std::atomic<uint64_t>) == sizeof(uint64_t)) && (sizeof(std::atomic<uint32_t>) == sizeof(uint32_t)),
+   "the counters in the segment are accessed as std::atomic");
+
+namespace
+{
+   // lock free atomics are address free, so they work across processes on the shared mapping
+   std::atomic<uint64_t>& Atomic(uint64_t& v) { return reinterpret_cast<std::atomic<uint64_t>&>(v); }
+   const std::atomic<uint64_t>& Atomic(const uint64_t& v) { return reinterpret_cast<const std::atomic<uint64_t>&>(v); }
+   std::atomic<uint32_t>& Atomic(uint32_t& v) { return reinterpret_cast<std::atomic<uint32_t>&>(v); }
+   const std::atomic<uint32_t>& Atomic(const uint32_t& v) { return reinterpret_cast<const std::atomic<uint32_t>&>(v); }
+
+   // rewrite the region from local (all but the sequence and the time) if it differs, the sequence is odd meanwhile
+   template<typename Region>
+   void WriteRegion(Region& shared, const Region& local, int64_t now)
+   {
+      constexpr size_t HEAD = sizeof(uint64_t) + sizeof(int64_t); // sequence, updatedNs
+      const uint8_t* src = reinterpret_cast<const uint8_t*>(&local) + HEAD;
+      uint8_t* dst = reinterpret_cast<uint8_t*>(&shared) + HEAD;
+      if (!memcmp(dst, src, sizeof(Region) - HEAD))
+         return;
+
+      std::atomic<uint64_t>& sequence = Atomic(shared.sequence);
+      const uint64_t v = sequence.load(std::memory_order_relaxed);
+      sequence.store(v + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release); // the odd sequence is visible before any byte of the region changes
+
+      shared.updatedNs = now;
+      memcpy(dst, src, sizeof(Region) - HEAD);
+      sequence.store(v + 2, std::memory_order_release);
+   }
+
+   bool ValidHeader(const F12020SharedStateHeader& header)
+   {
+      if (memcmp(header.magic, F12020_SHARED_STATE_MAGIC, sizeof(header.magic)))
+         return false;
+      std::atomic_thread_fence(std::memory_order_acquire); // the magic is written last
+
+      return (header.version == F12020_SHARED_STATE_VERSION) && (header.headerSize == sizeof(F12020SharedStateHeader)) &&
+         (header.size == sizeof(F12020SharedState)) && (header.carSize == sizeof(F12020SharedCar)) &&
+         (header.eventSize == sizeof(F12020SharedEvent));
+   }
+
+#ifndef _WIN32
+   // true if there is no segment of the name or its writer is gone: another layout, closed or the process ended
+   bool Replaceable(const char* name)
+   {
+      int fd = shm_open(name, O_RDONLY | O_CLOEXEC, 0);
+      if (fd < 0)
+         return errno == ENOENT;
+
+      struct stat st;
+      void* data = MAP_FAILED;
+      if (!fstat(fd, &st) && (st.st_size >= static_cast<off_t>(sizeof(F12020SharedStateHeader))))
+         data = mmap(nullptr, sizeof(F12020SharedStateHeader), PROT_READ, MAP_SHARED, fd, 0);
+      close(fd);
+      if (data == MAP_FAILED)
+         return true;
+
+      const F12020SharedStateHeader& header = *static_cast<const F12020SharedStateHeader*>(data);
+      const bool replaceable = !ValidHeader(header) || !Atomic(header.live).load(std::memory_order_acquire) ||
+         ((kill(static_cast<pid_t>(header.writerPid), 0) != 0) && (errno == ESRCH));
+      munmap(data, sizeof(F12020SharedStateHeader));
+      return replaceable;
+   }
+#endif
+}
+
+F12020SharedStateWriter::~F12020SharedStateWriter()
+{
+   Close();
+}
+
+bool F12020SharedStateWriter::Open(const char* name)
+{
+   Close();
+
+#ifdef _WIN32
+   HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, sizeof(F12020SharedState), name);
+   if (!mapping)
+      return false;
+   if (GetLastError() == ERROR_ALREADY_EXISTS)
+   {
+      CloseHandle(mapping);
+      return false;
+   }
+
+   // the view keeps the mapping and its name alive
+   void* data = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, sizeof(F12020SharedState));
+   CloseHandle(mapping);
+   if (!data)
+      return false;
+   const uint32_t pid = GetCurrentProcessId();
+#else
+   if (strlen(name) >= sizeof(m_name))
+      return false;
+
+   // a new segment each time, the readers of a replaced one see it as not live and open the name again.
+   // Only the segment of a closed or crashed writer is replaced, a live writer keeps its name (as on Windows).
+   if (!Replaceable(name))
+      return false;
+   shm_unlink(name);
+   int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, 0644);
+   if (fd < 0)
+      return false;
+
+   void* data = MAP_FAILED;
+   if (ftruncate(fd, sizeof(F12020SharedState)) == 0)
+      data = mmap(nullptr, sizeof(F12020SharedState), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+   if (data == MAP_FAILED)
+   {
+      close(fd);
+      shm_unlink(name);
+      return false;
+   }
+
+   m_fd = fd;
+   strcpy(m_name, name);
+   const uint32_t pid = static_cast<uint32_t>(getpid());
+#endif
+
+   m_state = static_cast<F12020SharedState*>(data);
+   memset(m_state, 0, sizeof(F12020SharedState));
+
+   F12020SharedStateHeader& header = m_state->header;
+   header.version = F12020_SHARED_STATE_VERSION;
+   header.headerSize = sizeof(F12020SharedStateHeader);
+   header.size = sizeof(F12020SharedState);
+   header.carSize = sizeof(F12020SharedCar);
+   header.eventSize = sizeof(F12020SharedEvent);
+   header.writerPid = pid;
+   header.createdNs = F12020CaptureNow();
+   header.live = 1;
+   std::atomic_thread_fence(std::memory_order_release);
+   memcpy(header.magic, F12020_SHARED_STATE_MAGIC, sizeof(header.magic));
+   return true;
+}
+
+void F12020SharedStateWriter::Close()
+{
+   if (!m_state)
+      return;
+
+   Atomic(m_state->header.live).store(0, std::memory_order_release);
+
+#ifdef _WIN32
+   UnmapViewOfFile(m_state);
+#else
+   munmap(m_state, sizeof(F12020SharedState));
+
+   // remove the name unless another writer has replaced the segment meanwhile
+   int fd = shm_open(m_name, O_RDONLY | O_CLOEXEC, 0);
+   if (fd >= 0)
+   {
+      struct stat own, named;
+      if (!fstat(m_fd, &own) && !fstat(fd, &named) && (own.st_dev == named.st_dev) && (own.st_ino == named.st_ino))
+         shm_unlink(m_name);
+      close(fd);
+   }
+   close(m_fd);
+   m_fd = -1;
+   m_name[0] = 0;
+#endif
+
+   m_state = nullptr;
+}
+
+void F12020SharedState::Capture(const F12020SessionEngine& engine)
+{
+   // incl. the padding, the records are compared bytewise
+   memset(&session, 0, sizeof(session));
+   memset(&cars, 0, sizeof(cars));
+   memset(&events, 0, sizeof(events));
+
+   const F12020SessionState& s = engine.session;
+   session.generation = engine.generation;
+   session.frames = engine.frames;
+   session.track = s.track;
+   session.sessionType = s.sessionType;
+   session.remainingTime = s.remainingTime;
+   session.totalLaps = s.totalLaps;
+   session.currentLap = s.currentLap;
+   session.countDrivers = s.countDrivers;
+   session.playerIdx = s.playerIdx;
+   session.leaderIdx = s.leaderIdx;
+   session.sessionFinished = s.sessionFinished;
+   session.classifiedCars = engine.classifiedCars;
+
+   for (int i = 0; i < F12020_MAX_CARS; ++i)
+   {
+      const F12020DriverState& driver = engine.drivers[i];
+      const ParticipantData& participant = engine.parser.participants.m_participants[i];
+      F12020SharedCar& car = cars.car[i];
+
+      memcpy(car.name, participant.m_name, sizeof(car.name));
+      car.name[sizeof(car.name) - 1] = 0;
+      car.present = driver.present;
+      car.isPlayer = driver.isPlayer;
+      car.status = static_cast<uint8_t>(driver.status);
+      car.team = driver.team;
+      car.driverId = participant.m_driverId;
+      car.raceNumber = participant.m_raceNumber;
+      car.aiControlled = participant.m_aiControlled;
+      car.tyre = driver.tyre;
+      car.visualTyre = driver.visualTyre;
+      car.stints = static_cast<uint8_t>(driver.numVisualTyres);
+      for (int j = 0; j < driver.numPitPenalties; ++j)
+      {
+         if (!engine.events[driver.pitPenalties[j]].penaltyServed)
+            ++car.pitPenalties;
+      }
+      car.pos = driver.pos;
+      car.lapNr = driver.lapNr;
+      car.tyreAge = driver.tyreAge;
+      car.penaltySeconds = driver.penaltySeconds;
+      car.fastestLap = driver.fastestLap;
+      car.lastLap = engine.laps.Lap(i, driver.lapNr - 1).lap;
+      car.timedeltaToPlayer = driver.timedeltaToPlayer;
+      car.timedeltaToLeader = driver.timedeltaToLeader;
+   }
+
+   events.count = static_cast<uint32_t>(engine.events.size());
+   for (uint32_t n = std::max(events.count, F12020_SHARED_EVENTS) - F12020_SHARED_EVENTS; n < events.count; ++n)
+   {
+      const F12020SessionEvent& native = engine.events[n];
+      F12020SharedEvent& e = events.event[n % F12020_SHARED_EVENTS];
+      e.sessionTime = native.sessionTime;
+      e.lapTime = native.lapTime;
+      e.speed = native.speed;
+      e.type = static_cast<uint8_t>(native.type);
+      e.carIndex = native.carIndex;
+      e.penaltyType = native.penaltyType;
+      e.infringementType = native.infringementType;
+      e.otherVehicleIdx = native.otherVehicleIdx;
+      e.timeGained = native.timeGained;
+      e.lapNum = native.lapNum;
+      e.placesGained = native.placesGained;
+      e.penaltyServed = native.penaltyServed;
+   }
+}
+
+void F12020SharedStateWriter::Publish(const F12020SharedState& state)
+{
+   if (!m_state)
+      return;
+
+   // only written if a region changed
+   const int64_t now = F12020CaptureNow();
+   WriteRegion(m_state->session, state.session, now);
+   WriteRegion(m_state->cars, state.cars, now);
+   WriteRegion(m_state->events, state.events, now);
+}
+
+F12020SharedStateReader::~F12020SharedStateReader()
+{
+   Close();
+}
+
+bool F12020SharedStateReader::Open(const char* name)
+{
+   Close();
+
+#ifdef _WIN32
+   HANDLE mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, name);
+   if (!mapping)
+      return false;
+   const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, sizeof(F12020SharedState));
+   CloseHandle(mapping);
+   if (!data)
+      return false;
+#else
+   int fd = shm_open(name, O_RDONLY | O_CLOEXEC, 0);
+   if (fd < 0)
+      return false;
+
+   struct stat st;
+   if ((fstat(fd, &st) < 0) || (st.st_size < static_cast<off_t>(sizeof(F12020SharedState))))
+   {
+      close(fd);
+      return false;
+   }
+
+   void* data = mmap(nullptr, sizeof(F12020SharedState), PROT_READ, MAP_SHARED, fd, 0);
+   close(fd);
+   if (data == MAP_FAILED)
+      return false;
+#endif
+
+   m_state = static_cast<const F12020SharedState*>(data);
+   if (!ValidHeader(m_state->header))
+   {
+      Close();
+      return false;
+   }
+   return true;
+}
+
+void F12020SharedStateReader::Close()
+{
+   if (!m_state)
+      return;
+
+#ifdef _WIN32
+   UnmapViewOfFile(m_state);
+#else
+   munmap(const_cast<F12020SharedState*>(m_state), sizeof(F12020SharedState));
+#endif
+   m_state = nullptr;
+}
+
+bool F12020SharedStateReader::Live() const
+{
+   return m_state && Atomic(m_state->header.live).load(std::memory_order_acquire);
+}
+
+uint64_t F12020SharedStateReader::BeginRead(const uint64_t& sequence) const
+{
+   for (;;)
+   {
+      const uint64_t v = Atomic(sequence).load(std::memory_order_acquire);
+      if (!(v & 1))
+         return v;
+      std::this_thread::yield(); // the writer copies a few KB at most
+   }
+}
+
+bool F12020SharedStateReader::EndRead(const uint64_t& sequence, uint64_t begin) const
+{
+   std::atomic_thread_fence(std::memory_order_acquire); // the reads complete before the sequence is checked again
+   return Atomic(sequence).load(std::memory_order_relaxed) == begin;
+}
+
+bool F12020SharedStateReader::ReadEvent(uint32_t n, F12020SharedEvent& e) const
+{
+   const F12020SharedEvents& events = m_state->events;
+   for (;;)
+   {
+      const uint64_t begin = BeginRead(events.sequence);
+      const uint32_t count = events.count;
+      const bool available = (n < count) && (count - n <= F12020_SHARED_EVENTS);
+      if (available)
+         e = events.event[n % F12020_SHARED_EVENTS];
+      if (EndRead(events.sequence, begin))
+         return available;
+   }
+}
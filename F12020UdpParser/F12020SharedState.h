@@ -0,0 +1,191 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+#include <stdint.h>
+
+struct F12020SessionEngine;
+
+// The derived session state in a named shared memory segment, for any number of local processes (overlays, loggers)
+// which neither bind a UDP port nor parse: the engine thread writes it with every published frame
+// (see F12020EngineThread::StartSharing), the readers map it read only and read the records in place.
+// Segment layout (F12020SharedState, native byte order, natural alignment, each region on its own cache lines):
+//   header:  magic, layout version and record sizes, a reader refuses any other layout
+//   session: F12020SharedSession
+//   cars:    F12020_SHARED_CARS F12020SharedCar
+//   events:  the last F12020_SHARED_EVENTS of the event journal, event n at n % F12020_SHARED_EVENTS
+// Every region starts with its own sequence counter (seqlock), odd while the writer changes the region and only
+// incremented if the region actually changed. A reader reads between BeginRead() and EndRead() and retries if
+// EndRead() fails, the writer never waits for a reader.
+// POSIX: shm_open() segment (the name starts with '/'), Windows: named file mapping in the session namespace.
+// The implementation is native only (<atomic> is not available with /clr), the header is safe for managed code.
+
+constexpr char F12020_SHARED_STATE_MAGIC[8] = { 'F', '1', 'S', 'H', 'M', '2', '0', '\0' };
+constexpr uint16_t F12020_SHARED_STATE_VERSION = 1;
+constexpr uint32_t F12020_SHARED_EVENTS = 128;
+constexpr int F12020_SHARED_CARS = 22; // F12020_MAX_CARS
+
+#ifdef _WIN32
+constexpr char F12020_SHARED_STATE_NAME[] = "Local\\F12020SessionState";
+#else
+constexpr char F12020_SHARED_STATE_NAME[] = "/F12020SessionState";
+#endif
+
+struct alignas(64) F12020SharedStateHeader
+{
+   char magic[8];        // F12020_SHARED_STATE_MAGIC, written last when the segment is set up
+   uint16_t version;     // F12020_SHARED_STATE_VERSION
+   uint16_t headerSize;  // sizeof(F12020SharedStateHeader)
+   uint32_t size;        // sizeof(F12020SharedState)
+   uint16_t carSize;     // sizeof(F12020SharedCar)
+   uint16_t eventSize;   // sizeof(F12020SharedEvent)
+   uint32_t writerPid;
+   int64_t createdNs;    // unix time in ns
+   uint32_t live;        // 0 after the writer closed the segment, a reader opens the name again to follow a new writer
+};
+
+struct alignas(64) F12020SharedSession
+{
+   uint64_t sequence;    // seqlock, see F12020SharedStateReader
+   int64_t updatedNs;    // unix time in ns of the last change
+   uint32_t generation;  // F12020SessionEngine::generation, changes when a new session starts
+   uint32_t frames;      // F12020SessionEngine::frames
+   int32_t track;
+   int32_t sessionType;
+   int32_t remainingTime;
+   int32_t totalLaps;
+   int32_t currentLap;
+   int32_t countDrivers;
+   int32_t playerIdx;    // -1 in spectator mode
+   int32_t leaderIdx;
+   uint8_t sessionFinished;
+   uint8_t classifiedCars; // 0 if no classification available
+   uint8_t reserved[6];
+};
+
+struct F12020SharedCar
+{
+   char name[48];        // UTF-8, as sent in the participants packet
+   uint8_t present;
+   uint8_t isPlayer;
+   uint8_t status;       // F12020DriverStatus
+   uint8_t team;
+   uint8_t driverId;
+   uint8_t raceNumber;
+   uint8_t aiControlled;
+   uint8_t tyre;         // actual compound
+   uint8_t visualTyre;   // visual compound
+   uint8_t stints;       // tyre sets used, incl. the fitted one
+   uint8_t pitPenalties; // unserved drive through / stop go penalties
+   uint8_t reserved;
+   int32_t pos;
+   int32_t lapNr;
+   int32_t tyreAge;
+   int32_t penaltySeconds;
+   float fastestLap;
+   float lastLap;        // 0 before the first lap is completed
+   float timedeltaToPlayer;
+   float timedeltaToLeader;
+};
+
+struct alignas(64) F12020SharedCars
+{
+   uint64_t sequence;    // seqlock, see F12020SharedStateReader
+   int64_t updatedNs;
+   F12020SharedCar car[F12020_SHARED_CARS];
+};
+
+struct F12020SharedEvent
+{
+   float sessionTime;
+   float lapTime;        // FastestLap: lap time in seconds
+   float speed;          // SpeedTrapTriggered: top speed in km/h
+   uint8_t type;         // F12020EventType
+   uint8_t carIndex;
+   uint8_t penaltyType;
+   uint8_t infringementType;
+   uint8_t otherVehicleIdx;
+   uint8_t timeGained;
+   uint8_t lapNum;
+   uint8_t placesGained;
+   uint8_t penaltyServed; // may change after the event was written
+   uint8_t reserved[3];
+};
+
+struct alignas(64) F12020SharedEvents
+{
+   uint64_t sequence;    // seqlock, see F12020SharedStateReader
+   int64_t updatedNs;
+   uint32_t count;       // size of the event journal, the last F12020_SHARED_EVENTS of it are in event
+   uint32_t reserved;
+   F12020SharedEvent event[F12020_SHARED_EVENTS];
+};
+
+struct F12020SharedState
+{
+   F12020SharedStateHeader header;
+   F12020SharedSession session;
+   F12020SharedCars cars;
+   F12020SharedEvents events;
+
+   // the session, car and event records of the engine state (not the header), sequences and times zero
+   void Capture(const F12020SessionEngine& engine);
+};
+
+// Creates the segment and writes the engine state into it, used by one thread at a time.
+struct F12020SharedStateWriter
+{
+   F12020SharedStateWriter() = default;
+   ~F12020SharedStateWriter();
+   F12020SharedStateWriter(const F12020SharedStateWriter&) = delete;
+   F12020SharedStateWriter& operator=(const F12020SharedStateWriter&) = delete;
+
+   // create the segment, false on error or if another writer is live on the name. POSIX: a segment of the same name is
+   // replaced if its writer closed it or is gone (e.g. crashed), Windows: fails as long as the name exists, i.e. another
+   // writer or a reader of a closed segment still maps it.
+   bool Open(const char* name = F12020_SHARED_STATE_NAME);
+
+   // mark the segment as not live and remove the name, the readers keep their mapping until they close it
+   void Close();
+   bool IsOpen() const { return m_state != nullptr; }
+
+   // copy the records of state (see F12020SharedState::Capture), only the regions which changed are rewritten
+   void Publish(const F12020SharedState& state);
+
+private:
+   F12020SharedState* m_state{ nullptr };
+#ifndef _WIN32
+   int m_fd{ -1 };       // to find out if the name still refers to this segment when closing
+   char m_name[256]{};
+#endif
+};
+
+// Read only view of the segment of another process, nothing is copied.
+//   const F12020SharedState& s = *reader.State();
+//   uint64_t seq;
+//   do { seq = reader.BeginRead(s.cars.sequence); pos = s.cars.car[i].pos; ... } while (!reader.EndRead(s.cars.sequence, seq));
+struct F12020SharedStateReader
+{
+   F12020SharedStateReader() = default;
+   ~F12020SharedStateReader();
+   F12020SharedStateReader(const F12020SharedStateReader&) = delete;
+   F12020SharedStateReader& operator=(const F12020SharedStateReader&) = delete;
+
+   // map the segment, false if there is none (yet) or it has another layout
+   bool Open(const char* name = F12020_SHARED_STATE_NAME);
+   void Close();
+
+   const F12020SharedState* State() const { return m_state; }
+   bool Live() const; // false once the writer closed the segment
+
+   // seqlock of a region: BeginRead waits while the region is written and returns its sequence,
+   // EndRead is false if the region changed meanwhile, then whatever was read in between must be read again
+   uint64_t BeginRead(const uint64_t& sequence) const;
+   bool EndRead(const uint64_t& sequence, uint64_t begin) const;
+
+   // copy event n of the journal, false if it is not written yet or already overwritten
+   bool ReadEvent(uint32_t n, F12020SharedEvent& e) const;
+
+private:
+   const F12020SharedState* m_state{ nullptr };
+};
@@ -0,0 +1,217 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+// compiled without /clr, see F12020UdpParser.vcxproj
+
+#include "F12020StateSnapshot.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <string.h>
+
+void F12020EngineSnapshot::Capture(const F12020SessionEngine& engine)
+{
+   generation = engine.generation;
+   frames = engine.frames;
+   session = engine.session;
+   memcpy(drivers, engine.drivers, sizeof(drivers));
+   cars = engine.cars;
+   memcpy(participants, engine.parser.participants.m_participants, sizeof(participants));
+   classifiedCars = engine.classifiedCars;
+   memcpy(classification, engine.classification, sizeof(classification));
+
+   for (int i = 0; i < F12020_MAX_CARS; ++i)
+   {
+      const F12020DriverState& driver = engine.drivers[i];
+
+      servedPitPenalties[i] = 0;
+      for (int j = 0; j < driver.numPitPenalties; ++j)
+      {
+         if (engine.events[driver.pitPenalties[j]].penaltyServed)
+            servedPitPenalties[i] |= 1u << j;
+      }
+
+      for (int lapNr = driver.lapNr - F12020_SNAPSHOT_LAPS + 1; lapNr <= driver.lapNr; ++lapNr)
+      {
+         if (lapNr >= 1)
+            m_laps[i][(lapNr - 1) % F12020_SNAPSHOT_LAPS] = engine.laps.Lap(i, lapNr);
+      }
+   }
+
+   events = static_cast<uint32_t>(engine.events.size());
+}
+
+F12020LapTimes F12020EngineSnapshot::Lap(int car, int lapNr) const
+{
+   const int lapNrCar = drivers[car].lapNr;
+   if ((lapNr < 1) || (lapNr > lapNrCar) || (lapNr <= lapNrCar - F12020_SNAPSHOT_LAPS))
+      return F12020LapTimes{};
+
+   return m_laps[car][(lapNr - 1) % F12020_SNAPSHOT_LAPS];
+}
+
+int F12020EngineSnapshot::FinalLaps(int car) const
+{
+   return std::min(std::max(drivers[car].lapNr - F12020_SNAPSHOT_LAPS, 0), F12020_HISTORY_LAPS);
+}
+
+F12020LapTimes F12020SnapshotHistory::Lap(const F12020EngineSnapshot& snapshot, int car, int lapNr) const
+{
+   if (lapNr > snapshot.FinalLaps(car))
+      return snapshot.Lap(car, lapNr);
+
+   const auto& laps = finalLaps[car];
+   return ((lapNr >= 1) && (static_cast<size_t>(lapNr) <= laps.size())) ? laps[lapNr - 1] : F12020LapTimes{};
+}
+
+namespace
+{
+   constexpr int HISTORY_CHUNKS = F12020_HISTORY_LAPS / F12020_LAP_CHUNK;
+}
+
+struct F12020SnapshotBuffer::State
+{
+   F12020EngineSnapshot buffers[2];
+   std::atomic<uint64_t> versions[2]{}; // odd while the buffer is written
+   std::atomic<uint64_t> published{ 0 }; // snapshot n is in buffers[n & 1]
+
+   // the history: entries are written once before the snapshot counting them is published, and only written again
+   // for a new session, after historyGeneration changed
+   std::atomic<uint32_t> historyGeneration{ 0 };
+   F12020SessionEvent journal[F12020_MAX_EVENTS];
+   std::atomic<F12020LapTimes*> lapChunks[F12020_MAX_CARS][HISTORY_CHUNKS]{}; // taken when reached, kept until destruction
+   uint32_t historyEvents{ 0 };        // writer only
+   int historyLaps[F12020_MAX_CARS]{}; // writer only
+
+   ~State()
+   {
+      for (auto& chunks : lapChunks)
+      {
+         for (auto& chunk : chunks)
+            delete[] chunk.load();
+      }
+   }
+
+   void AppendHistory(const F12020SessionEngine& engine);
+   bool ReadHistory(const F12020EngineSnapshot& snapshot, F12020SnapshotHistory& history) const;
+};
+
+void F12020SnapshotBuffer::State::AppendHistory(const F12020SessionEngine& engine)
+{
+   if (engine.generation != historyGeneration.load(std::memory_order_relaxed))
+   {
+      historyGeneration.store(engine.generation, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release); // the new generation is visible before any entry is rewritten
+      historyEvents = 0;
+      std::fill(std::begin(historyLaps), std::end(historyLaps), 0);
+   }
+
+   const uint32_t events = static_cast<uint32_t>(engine.events.size());
+   std::copy(engine.events.data() + historyEvents, engine.events.data() + events, journal + historyEvents);
+   historyEvents = events;
+
+   for (int i = 0; i < F12020_MAX_CARS; ++i)
+   {
+      const int finalLaps = std::min(std::max(engine.drivers[i].lapNr - F12020_SNAPSHOT_LAPS, 0), F12020_HISTORY_LAPS);
+      for (int lapNr = historyLaps[i] + 1; lapNr <= finalLaps; ++lapNr)
+      {
+         std::atomic<F12020LapTimes*>& chunk = lapChunks[i][(lapNr - 1) / F12020_LAP_CHUNK];
+         if (!chunk.load(std::memory_order_relaxed))
+            chunk.store(new F12020LapTimes[F12020_LAP_CHUNK], std::memory_order_release);
+         chunk.load(std::memory_order_relaxed)[(lapNr - 1) % F12020_LAP_CHUNK] = engine.laps.Lap(i, lapNr);
+      }
+      historyLaps[i] = std::max(historyLaps[i], finalLaps);
+   }
+}
+
+bool F12020SnapshotBuffer::State::ReadHistory(const F12020EngineSnapshot& snapshot, F12020SnapshotHistory& history) const
+{
+   if (history.generation != snapshot.generation)
+   {
+      history.generation = snapshot.generation;
+      history.events.clear();
+      for (auto& laps : history.finalLaps)
+         laps.clear();
+   }
+
+   // only the entries the reader is missing, rolled back if the writer started to rewrite the history meanwhile
+   const size_t events = history.events.size();
+   size_t laps[F12020_MAX_CARS];
+   for (int i = 0; i < F12020_MAX_CARS; ++i)
+      laps[i] = history.finalLaps[i].size();
+
+   if (snapshot.events > events)
+      history.events.insert(history.events.end(), journal + events, journal + snapshot.events);
+
+   for (int i = 0; i < F12020_MAX_CARS; ++i)
+   {
+      for (int lapNr = static_cast<int>(laps[i]) + 1; lapNr <= snapshot.FinalLaps(i); ++lapNr)
+      {
+         const F12020LapTimes* chunk = lapChunks[i][(lapNr - 1) / F12020_LAP_CHUNK].load(std::memory_order_acquire);
+         history.finalLaps[i].push_back(chunk ? chunk[(lapNr - 1) % F12020_LAP_CHUNK] : F12020LapTimes{});
+      }
+   }
+
+   std::atomic_thread_fence(std::memory_order_acquire); // the copies complete before the generation is checked again
+   if (historyGeneration.load(std::memory_order_relaxed) == snapshot.generation)
+      return true;
+
+   history.events.resize(events);
+   for (int i = 0; i < F12020_MAX_CARS; ++i)
+      history.finalLaps[i].resize(laps[i]);
+   return false;
+}
+
+F12020SnapshotBuffer::F12020SnapshotBuffer()
+{
+   m_state = new State();
+}
+
+F12020SnapshotBuffer::~F12020SnapshotBuffer()
+{
+   delete m_state;
+}
+
+void F12020SnapshotBuffer::Publish(const F12020SessionEngine& engine)
+{
+   const uint64_t next = m_state->published.load(std::memory_order_relaxed) + 1;
+   std::atomic<uint64_t>& version = m_state->versions[next & 1];
+   const uint64_t v = version.load(std::memory_order_relaxed);
+
+   m_state->AppendHistory(engine); // before the snapshot which counts the entries is published
+   version.store(v + 1, std::memory_order_relaxed);
+   std::atomic_thread_fence(std::memory_order_release); // the odd version is visible before any byte of the buffer changes
+   m_state->buffers[next & 1].Capture(engine);
+   version.store(v + 2, std::memory_order_release);
+   m_state->published.store(next, std::memory_order_release);
+}
+
+bool F12020SnapshotBuffer::Read(F12020EngineSnapshot& snapshot, F12020SnapshotHistory& history, uint64_t& sequence) const
+{
+   for (;;)
+   {
+      const uint64_t n = m_state->published.load(std::memory_order_acquire);
+      if (!n || (n == sequence))
+         return false;
+
+      const std::atomic<uint64_t>& version = m_state->versions[n & 1];
+      const uint64_t before = version.load(std::memory_order_acquire);
+      if (before & 1)
+         continue; // already rewritten, a newer snapshot is published
+
+      memcpy(&snapshot, &m_state->buffers[n & 1], sizeof(snapshot));
+      std::atomic_thread_fence(std::memory_order_acquire); // the copy completes before the version is checked again
+      // with the history rewritten for a new session meanwhile, that session is about to be published
+      if ((version.load(std::memory_order_relaxed) == before) && m_state->ReadHistory(snapshot, history))
+      {
+         sequence = n;
+         return true;
+      }
+   }
+}
+
+uint64_t F12020SnapshotBuffer::Published() const
+{
+   return m_state->published.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,87 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include "F12020SessionEngine.h"
+
+// Self contained copy of the engine state for readers on other threads, e.g. the UI projecting it onto the CLR objects.
+// It holds what a projection reads: the derived state, the participants and the tail of the lap history, which still
+// changes while driving. The events and the older laps never change, they are appended to the F12020SnapshotHistory
+// of each reader instead, so a reader gets all of them however many snapshots it skipped.
+
+constexpr int F12020_SNAPSHOT_LAPS = 4; // latest laps of each car in a snapshot, the older ones are final
+constexpr int F12020_HISTORY_LAPS = 4096; // final laps of each car kept for the readers of a F12020SnapshotBuffer
+
+struct F12020EngineSnapshot
+{
+   uint32_t generation{ 0 }; // see F12020SessionEngine
+   uint32_t frames{ 0 };
+
+   F12020SessionState session;
+   F12020DriverState drivers[F12020_MAX_CARS]{};
+   uint32_t servedPitPenalties[F12020_MAX_CARS]{}; // bit j: the event of drivers[i].pitPenalties[j] is served
+   F12020CarStateStore cars{};
+   ParticipantData participants[F12020_MAX_CARS]{};
+
+   uint8_t classifiedCars{ 0 };
+   FinalClassificationData classification[F12020_MAX_CARS]{};
+
+   uint32_t events{ 0 }; // size of the event journal
+
+   void Capture(const F12020SessionEngine& engine);
+
+   // lapNr counts from 1, zero if not driven or older than F12020_SNAPSHOT_LAPS before drivers[car].lapNr
+   F12020LapTimes Lap(int car, int lapNr) const;
+
+   // laps of the car older than F12020_SNAPSHOT_LAPS before drivers[car].lapNr, they are in the history
+   int FinalLaps(int car) const;
+
+private:
+   F12020LapTimes m_laps[F12020_MAX_CARS][F12020_SNAPSHOT_LAPS]{}; // lap n at (n - 1) % F12020_SNAPSHOT_LAPS
+};
+
+// The events and final laps of one session as far as a reader has read them, i.e. its cursor into the history of
+// a F12020SnapshotBuffer. F12020SnapshotBuffer::Read appends what is new up to the snapshot read and starts over
+// with a new generation. Owned by the reader thread.
+struct F12020SnapshotHistory
+{
+   uint32_t generation{ 0 };
+   std::vector<F12020SessionEvent> events;                // the journal up to F12020EngineSnapshot::events
+   std::vector<F12020LapTimes> finalLaps[F12020_MAX_CARS]; // lap n at n - 1, see F12020EngineSnapshot::FinalLaps
+
+   // event n of the journal, nullptr if not read yet
+   const F12020SessionEvent* Event(uint32_t n) const { return (n < events.size()) ? &events[n] : nullptr; }
+
+   // lapNr counts from 1: from the tail of the snapshot or from the final laps, zero if not driven
+   F12020LapTimes Lap(const F12020EngineSnapshot& snapshot, int car, int lapNr) const;
+};
+
+// The latest snapshot of one writer (the engine thread) for any number of readers, no side takes a lock.
+// Two buffers under sequence counters (seqlock): the writer fills the buffer not published and then publishes it,
+// a reader copies the published buffer and only retries if the writer came round to that buffer during the copy,
+// i.e. published twice meanwhile. The writer never waits, a reader is lock-free but not wait-free: it retries as
+// long as the writer publishes twice within one copy, which the frame rate of the game does not come near.
+// Besides the buffers the writer appends the events and final laps to a history shared by the readers, which is only
+// rewritten when a new session starts (generation). The implementation is native only (<atomic> is not available with /clr).
+struct F12020SnapshotBuffer
+{
+   F12020SnapshotBuffer();
+   ~F12020SnapshotBuffer();
+   F12020SnapshotBuffer(const F12020SnapshotBuffer&) = delete;
+   F12020SnapshotBuffer& operator=(const F12020SnapshotBuffer&) = delete;
+
+   // writer: capture the engine state and make it the latest snapshot
+   void Publish(const F12020SessionEngine& engine);
+
+   // copy the latest snapshot if it is newer than sequence (0: none read yet) and update sequence, false if there is none.
+   // history is brought up to the snapshot, only the events and laps it is missing are copied.
+   bool Read(F12020EngineSnapshot& snapshot, F12020SnapshotHistory& history, uint64_t& sequence) const;
+
+   uint64_t Published() const; // number of snapshots published
+
+private:
+   struct State;
+   State* m_state;
+};
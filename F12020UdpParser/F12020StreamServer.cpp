@@ -0,0 +1,733 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+// compiled without /clr, see F12020UdpParser.vcxproj
+
+#include "F12020StreamServer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <ctype.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#ifdef _MSC_VER
+#pragma comment(lib, "ws2_32.lib")
+#endif
+#else
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+#ifdef _WIN32
+   typedef SOCKET Socket;
+   constexpr Socket NO_SOCKET = INVALID_SOCKET;
+   constexpr int SEND_FLAGS = 0;
+   void CloseSocket(Socket s) { closesocket(s); }
+   int Poll(pollfd* fds, unsigned count, int timeoutMs) { return WSAPoll(fds, count, timeoutMs); }
+   bool WouldBlock() { return WSAGetLastError() == WSAEWOULDBLOCK; }
+   bool SetNonBlocking(Socket s) { u_long on = 1; return !ioctlsocket(s, FIONBIO, &on); }
+#else
+   typedef int Socket;
+   constexpr Socket NO_SOCKET = -1;
+   constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+   void CloseSocket(Socket s) { close(s); }
+   int Poll(pollfd* fds, unsigned count, int timeoutMs) { return poll(fds, count, timeoutMs); }
+   bool WouldBlock() { return (errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR); }
+   bool SetNonBlocking(Socket s) { return fcntl(s, F_SETFL, fcntl(s, F_GETFL) | O_NONBLOCK) >= 0; }
+#endif
+
+   constexpr unsigned IMAGE_WORDS = F12020_STREAM_IMAGE_SIZE / 4;
+   constexpr int MAX_WAIT_MS = 100;           // Stop() is noticed after this at the latest
+   constexpr size_t MAX_REQUEST = 8 * 1024;   // HTTP upgrade request
+   constexpr size_t MAX_MESSAGE = 1024;       // client message
+   constexpr size_t MAX_BUFFERED = MAX_REQUEST; // unparsed input of a client, more than one request or message
+   constexpr char WEBSOCKET_GUID[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+   static_assert(F12020_STREAM_IMAGE_SIZE % 4 == 0, "the deltas are in words");
+   static_assert(IMAGE_WORDS <= 0xffff, "word offsets are 16 bit");
+
+   int64_t Now()
+   {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+   }
+
+   // SHA-1 for the WebSocket handshake (RFC 6455 4.2.2), nothing else depends on it
+   void Sha1(const uint8_t* pData, size_t len, uint8_t digest[20])
+   {
+      uint32_t h[5] = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+      std::vector<uint8_t> msg(pData, pData + len);
+      msg.push_back(0x80);
+      while (msg.size() % 64 != 56)
+         msg.push_back(0);
+      const uint64_t bits = static_cast<uint64_t>(len) * 8;
+      for (int i = 7; i >= 0; --i)
+         msg.push_back(static_cast<uint8_t>(bits >> (i * 8)));
+
+      auto rol = [](uint32_t v, int n) { return (v << n) | (v >> (32 - n)); };
+      for (size_t block = 0; block < msg.size(); block += 64)
+      {
+         uint32_t w[80];
+         for (int i = 0; i < 16; ++i)
+         {
+            const uint8_t* p = &msg[block + i * 4];
+            w[i] = (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+         }
+         for (int i = 16; i < 80; ++i)
+            w[i] = rol(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+         uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+         for (int i = 0; i < 80; ++i)
+         {
+            uint32_t f, k;
+            if (i < 20)
+               f = (b & c) | (~b & d), k = 0x5A827999;
+            else if (i < 40)
+               f = b ^ c ^ d, k = 0x6ED9EBA1;
+            else if (i < 60)
+               f = (b & c) | (b & d) | (c & d), k = 0x8F1BBCDC;
+            else
+               f = b ^ c ^ d, k = 0xCA62C1D6;
+            const uint32_t t = rol(a, 5) + f + e + k + w[i];
+            e = d; d = c; c = rol(b, 30); b = a; a = t;
+         }
+         h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e;
+      }
+
+      for (int i = 0; i < 20; ++i)
+         digest[i] = static_cast<uint8_t>(h[i / 4] >> (24 - (i % 4) * 8));
+   }
+
+   std::string Base64(const uint8_t* pData, size_t len)
+   {
+      static const char ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+      std::string out;
+      for (size_t i = 0; i < len; i += 3)
+      {
+         const uint32_t v = (uint32_t(pData[i]) << 16) | (i + 1 < len ? uint32_t(pData[i + 1]) << 8 : 0) | (i + 2 < len ? pData[i + 2] : 0);
+         out += ALPHABET[(v >> 18) & 63];
+         out += ALPHABET[(v >> 12) & 63];
+         out += (i + 1 < len) ? ALPHABET[(v >> 6) & 63] : '=';
+         out += (i + 2 < len) ? ALPHABET[v & 63] : '=';
+      }
+      return out;
+   }
+
+   // value of an HTTP header (name case insensitive), empty if missing
+   std::string HeaderValue(const std::string& request, const char* name)
+   {
+      const size_t nameLen = strlen(name);
+      for (size_t pos = request.find("\r\n"); pos != std::string::npos; pos = request.find("\r\n", pos + 2))
+      {
+         const size_t line = pos + 2;
+         if ((request.size() - line > nameLen) && (request[line + nameLen] == ':') &&
+            std::equal(name, name + nameLen, request.begin() + line, [](char a, char b) { return tolower(a) == tolower(b); }))
+         {
+            size_t begin = request.find_first_not_of(' ', line + nameLen + 1);
+            size_t end = request.find("\r\n", line);
+            if ((begin == std::string::npos) || (begin >= end))
+               return std::string();
+            return request.substr(begin, request.find_last_not_of(' ', end - 1) + 1 - begin);
+         }
+      }
+      return std::string();
+   }
+
+   enum class Protocol
+   {
+      Pending,   // nothing received yet
+      Tcp,
+      Upgrade,   // waiting for the end of the HTTP upgrade request
+      WebSocket
+   };
+
+   struct Client
+   {
+      Socket socket{ NO_SOCKET };
+      Protocol protocol{ Protocol::Pending };
+      bool closing{ false }; // close after the output is sent
+      bool failed{ false };  // close now
+
+      std::vector<uint8_t> in;
+      std::vector<uint8_t> out;
+      size_t outPos{ 0 };
+
+      unsigned rate{ 0 };    // 0 until HELLO
+      int64_t nextNs{ 0 };   // earliest time for the next message
+      bool resync{ true };   // a snapshot is due
+      uint32_t acked{ 0 };   // version of ackedImage, 0: none
+      uint32_t sent{ 0 };    // version in flight, 0: none
+      std::vector<uint8_t> ackedImage;
+      std::vector<uint8_t> sentImage;
+   };
+}
+
+struct F12020StreamServer::State
+{
+   Socket listener{ NO_SOCKET };
+   uint16_t port{ 0 };
+   std::thread thread;
+   std::atomic<bool> running{ false };
+   std::atomic<bool> stop{ false };
+
+   // the latest image, written by Publish()
+   std::mutex mutex;
+   std::vector<uint8_t> latest = std::vector<uint8_t>(F12020_STREAM_IMAGE_SIZE);
+   uint32_t version{ 0 }; // 0: nothing published yet
+
+   // server thread only
+   std::vector<std::unique_ptr<Client>> clients;
+   std::vector<uint8_t> image = std::vector<uint8_t>(F12020_STREAM_IMAGE_SIZE); // copy of latest
+   uint32_t imageVersion{ 0 };
+   std::vector<uint8_t> message;
+
+   std::atomic<unsigned> connected{ 0 };
+   std::atomic<uint64_t> snapshots{ 0 };
+   std::atomic<uint64_t> deltas{ 0 };
+   std::atomic<uint64_t> bytes{ 0 };
+
+   void Run();
+   void Accept();
+   void Receive(Client& client);
+   bool Handshake(Client& client);
+   void Parse(Client& client);
+   void HandleMessage(Client& client, const uint8_t* p, size_t len);
+   void Serve(Client& client, int64_t now);
+   void Frame(Client& client, uint8_t opcode, const uint8_t* p, size_t len);
+   void Flush(Client& client);
+};
+
+void F12020StreamServer::State::Run()
+{
+   std::vector<pollfd> fds;
+   while (!stop.load())
+   {
+      // wake up for the next client due, or to look at stop
+      const int64_t now = Now();
+      int64_t waitNs = MAX_WAIT_MS * 1000000ll;
+      for (const auto& client : clients)
+      {
+         if (client->rate && !client->sent && client->out.empty())
+            waitNs = std::min(waitNs, std::max<int64_t>(client->nextNs - now, 0));
+      }
+
+      fds.resize(clients.size() + 1);
+      fds[0].fd = listener;
+      fds[0].events = POLLIN;
+      fds[0].revents = 0;
+      for (size_t i = 0; i < clients.size(); ++i)
+      {
+         fds[i + 1].fd = clients[i]->socket;
+         fds[i + 1].events = POLLIN | (clients[i]->out.empty() ? 0 : POLLOUT);
+         fds[i + 1].revents = 0;
+      }
+
+      if (Poll(fds.data(), static_cast<unsigned>(fds.size()), static_cast<int>((waitNs + 999999) / 1000000)) < 0)
+      {
+         std::this_thread::sleep_for(std::chrono::milliseconds(1)); // EINTR
+         continue;
+      }
+
+      for (size_t i = 0; i < clients.size(); ++i)
+      {
+         Client& client = *clients[i];
+         const short revents = fds[i + 1].revents;
+         if (revents & (POLLIN | POLLERR | POLLHUP))
+            Receive(client);
+         if (revents & POLLOUT)
+            Flush(client);
+      }
+      if (fds[0].revents & POLLIN)
+         Accept();
+
+      // the clients which are due get the latest state
+      {
+         std::lock_guard<std::mutex> lock(mutex);
+         if (imageVersion != version)
+         {
+            image = latest;
+            imageVersion = version;
+         }
+      }
+      const int64_t served = Now();
+      for (const auto& client : clients)
+         Serve(*client, served);
+
+      clients.erase(std::remove_if(clients.begin(), clients.end(), [](const std::unique_ptr<Client>& client)
+      {
+         if (client->failed || (client->closing && client->out.empty()))
+         {
+            CloseSocket(client->socket);
+            return true;
+         }
+         return false;
+      }), clients.end());
+      connected.store(static_cast<unsigned>(clients.size()));
+   }
+
+   for (const auto& client : clients)
+      CloseSocket(client->socket);
+   clients.clear();
+   connected.store(0);
+}
+
+void F12020StreamServer::State::Accept()
+{
+   for (;;)
+   {
+      Socket s = accept(listener, nullptr, nullptr);
+      if (s == NO_SOCKET)
+         return;
+
+      if ((clients.size() >= F12020_STREAM_MAX_CLIENTS) || !SetNonBlocking(s))
+      {
+         CloseSocket(s);
+         continue;
+      }
+
+      int on = 1;
+      setsockopt(s, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&on), sizeof(on));
+
+      std::unique_ptr<Client> client(new Client());
+      client->socket = s;
+      clients.push_back(std::move(client));
+   }
+}
+
+void F12020StreamServer::State::Receive(Client& client)
+{
+   // parsed after every recv, so only an incomplete request or message stays buffered, however much the client sends
+   uint8_t buffer[4096];
+   while (!client.failed)
+   {
+      const int received = static_cast<int>(recv(client.socket, reinterpret_cast<char*>(buffer), sizeof(buffer), 0));
+      if (received > 0)
+      {
+         if (client.closing)
+            continue; // only the output is sent any more
+
+         client.in.insert(client.in.end(), buffer, buffer + received);
+         Parse(client);
+         if (client.in.size() > MAX_BUFFERED)
+            client.failed = true;
+         continue;
+      }
+
+      if ((received == 0) || !WouldBlock())
+         client.failed = true; // closed by the client or reset
+      break;
+   }
+}
+
+bool F12020StreamServer::State::Handshake(Client& client)
+{
+   const uint8_t* end = reinterpret_cast<const uint8_t*>("\r\n\r\n");
+   auto it = std::search(client.in.begin(), client.in.end(), end, end + 4);
+   if (it == client.in.end())
+   {
+      client.failed = client.in.size() > MAX_REQUEST;
+      return false;
+   }
+
+   const std::string request(client.in.begin(), it + 2);
+   client.in.erase(client.in.begin(), it + 4);
+   client.protocol = Protocol::WebSocket; // the response is no frame
+
+   const std::string key = HeaderValue(request, "Sec-WebSocket-Key");
+   std::string response;
+   if (key.empty())
+   {
+      response = "HTTP/1.1 400 Bad Request\r\nConnection: close\r\nContent-Length: 0\r\n\r\n";
+      client.closing = true;
+   }
+   else
+   {
+      const std::string accept = key + WEBSOCKET_GUID;
+      uint8_t digest[20];
+      Sha1(reinterpret_cast<const uint8_t*>(accept.data()), accept.size(), digest);
+      response = "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Accept: " +
+         Base64(digest, sizeof(digest)) + "\r\n\r\n";
+   }
+
+   client.out.insert(client.out.end(), response.begin(), response.end());
+   Flush(client);
+   return !client.closing;
+}
+
+void F12020StreamServer::State::Parse(Client& client)
+{
+   if (client.protocol == Protocol::Pending)
+   {
+      if (client.in.size() < 4)
+         return;
+      client.protocol = memcmp(client.in.data(), "GET ", 4) ? Protocol::Tcp : Protocol::Upgrade;
+   }
+
+   if (client.protocol == Protocol::Upgrade)
+   {
+      if (!Handshake(client))
+         return;
+      client.protocol = Protocol::WebSocket;
+   }
+
+   size_t pos = 0;
+   while (!client.failed && !client.closing)
+   {
+      const uint8_t* p = client.in.data() + pos;
+      const size_t available = client.in.size() - pos;
+
+      if (client.protocol == Protocol::Tcp)
+      {
+         uint32_t size;
+         if (available < sizeof(size))
+            break;
+         memcpy(&size, p, sizeof(size));
+         if (size > MAX_MESSAGE)
+         {
+            client.failed = true;
+            break;
+         }
+         if (available < sizeof(size) + size)
+            break;
+
+         HandleMessage(client, p + sizeof(size), size);
+         pos += sizeof(size) + size;
+         continue;
+      }
+
+      // WebSocket frame from the client: always masked, no fragments expected for our short messages
+      if (available < 2)
+         break;
+      const uint8_t opcode = p[0] & 0x0f;
+      const bool masked = (p[1] & 0x80) != 0;
+      size_t len = p[1] & 0x7f;
+      size_t header = 2;
+      if (len == 126)
+      {
+         if (available < 4)
+            break;
+         len = (size_t(p[2]) << 8) | p[3];
+         header = 4;
+      }
+      else if (len == 127)
+      {
+         client.failed = true; // larger than any request
+         break;
+      }
+
+      if (!masked || !(p[0] & 0x80) || (len > MAX_MESSAGE))
+      {
+         client.failed = true;
+         break;
+      }
+      if (available < header + 4 + len)
+         break;
+
+      uint8_t payload[MAX_MESSAGE];
+      const uint8_t* mask = p + header;
+      for (size_t i = 0; i < len; ++i)
+         payload[i] = p[header + 4 + i] ^ mask[i % 4];
+      pos += header + 4 + len;
+
+      if (opcode == 0x2)
+         HandleMessage(client, payload, len);
+      else if (opcode == 0x9)
+         Frame(client, 0xA, payload, len); // ping -> pong
+      else if (opcode == 0x8)
+      {
+         Frame(client, 0x8, payload, std::min<size_t>(len, 2)); // echo the status code
+         client.closing = true;
+      }
+      else if (opcode != 0xA)
+         client.failed = true; // text or continuation frames are not part of the protocol
+   }
+
+   client.in.erase(client.in.begin(), client.in.begin() + std::min(pos, client.in.size()));
+   Flush(client);
+}
+
+void F12020StreamServer::State::HandleMessage(Client& client, const uint8_t* p, size_t len)
+{
+   if (!len)
+      return;
+
+   switch (p[0])
+   {
+   case F12020_STREAM_HELLO:
+   case F12020_STREAM_RESYNC:
+   {
+      F12020StreamRequest request;
+      if (len < sizeof(request))
+         break;
+      memcpy(&request, p, sizeof(request));
+      client.rate = std::max(std::min<unsigned>(request.rate, F12020_STREAM_MAX_RATE), 1u);
+      if ((request.type == F12020_STREAM_RESYNC) || !client.acked)
+      {
+         client.resync = true;
+         client.sent = 0; // the message in flight is not waited for
+      }
+      break;
+   }
+
+   case F12020_STREAM_ACK:
+   {
+      F12020StreamAck ack;
+      if (len < sizeof(ack))
+         break;
+      memcpy(&ack, p, sizeof(ack));
+      if (client.sent && (ack.version == client.sent))
+      {
+         client.acked = client.sent;
+         client.ackedImage.swap(client.sentImage);
+         client.sent = 0;
+      }
+      break;
+   }
+
+   default:
+      break; // unknown messages are ignored, for later extensions
+   }
+}
+
+void F12020StreamServer::State::Serve(Client& client, int64_t now)
+{
+   if (!client.rate || client.sent || !client.out.empty() || client.closing || client.failed || (now < client.nextNs) || !imageVersion)
+      return;
+   if (!client.resync && (client.acked == imageVersion))
+      return; // nothing changed
+
+   message.clear();
+   if (client.resync)
+   {
+      F12020StreamSnapshot snapshot{};
+      snapshot.type = F12020_STREAM_SNAPSHOT;
+      snapshot.layout = F12020_SHARED_STATE_VERSION;
+      snapshot.version = imageVersion;
+      snapshot.size = F12020_STREAM_IMAGE_SIZE;
+      const uint8_t* h = reinterpret_cast<const uint8_t*>(&snapshot);
+      message.insert(message.end(), h, h + sizeof(snapshot));
+      message.insert(message.end(), image.begin(), image.end());
+      client.resync = false;
+      ++snapshots;
+   }
+   else
+   {
+      // runs of changed words, gaps of a single unchanged word are included (as cheap as a new run header)
+      F12020StreamDelta delta{};
+      delta.type = F12020_STREAM_DELTA;
+      delta.base = client.acked;
+      delta.version = imageVersion;
+      message.resize(sizeof(delta));
+
+      const uint32_t* current = reinterpret_cast<const uint32_t*>(image.data());
+      const uint32_t* base = reinterpret_cast<const uint32_t*>(client.ackedImage.data());
+      for (unsigned i = 0; i < IMAGE_WORDS;)
+      {
+         if (current[i] == base[i])
+         {
+            ++i;
+            continue;
+         }
+
+         unsigned end = i + 1;
+         while ((end < IMAGE_WORDS) && ((current[end] != base[end]) || ((end + 1 < IMAGE_WORDS) && (current[end + 1] != base[end + 1]))))
+            ++end;
+
+         F12020StreamRun run{ static_cast<uint16_t>(i), static_cast<uint16_t>(end - i) };
+         const uint8_t* r = reinterpret_cast<const uint8_t*>(&run);
+         message.insert(message.end(), r, r + sizeof(run));
+         message.insert(message.end(), reinterpret_cast<const uint8_t*>(current + i), reinterpret_cast<const uint8_t*>(current + end));
+         ++delta.runs;
+         i = end;
+      }
+
+      memcpy(message.data(), &delta, sizeof(delta));
+      ++deltas;
+   }
+
+   client.sent = imageVersion;
+   client.sentImage = image;
+   client.nextNs = now + 1000000000ll / client.rate;
+
+   Frame(client, 0x2, message.data(), message.size());
+   Flush(client);
+}
+
+void F12020StreamServer::State::Frame(Client& client, uint8_t opcode, const uint8_t* p, size_t len)
+{
+   uint8_t header[10];
+   size_t headerLen;
+   if (client.protocol == Protocol::Tcp)
+   {
+      const uint32_t size = static_cast<uint32_t>(len);
+      memcpy(header, &size, sizeof(size));
+      headerLen = sizeof(size);
+   }
+   else
+   {
+      // server frames are not masked, sizes in network byte order
+      header[0] = 0x80 | opcode;
+      if (len < 126)
+      {
+         header[1] = static_cast<uint8_t>(len);
+         headerLen = 2;
+      }
+      else if (len <= 0xffff)
+      {
+         header[1] = 126;
+         header[2] = static_cast<uint8_t>(len >> 8);
+         header[3] = static_cast<uint8_t>(len);
+         headerLen = 4;
+      }
+      else
+      {
+         header[1] = 127;
+         for (int i = 0; i < 8; ++i)
+            header[2 + i] = static_cast<uint8_t>(static_cast<uint64_t>(len) >> ((7 - i) * 8));
+         headerLen = 10;
+      }
+   }
+
+   client.out.insert(client.out.end(), header, header + headerLen);
+   client.out.insert(client.out.end(), p, p + len);
+}
+
+void F12020StreamServer::State::Flush(Client& client)
+{
+   while (client.outPos < client.out.size())
+   {
+      const int sent = static_cast<int>(send(client.socket, reinterpret_cast<const char*>(client.out.data() + client.outPos),
+         static_cast<int>(client.out.size() - client.outPos), SEND_FLAGS));
+      if (sent <= 0)
+      {
+         if (!WouldBlock())
+            client.failed = true;
+         return; // the rest when the socket is writable again
+      }
+      client.outPos += sent;
+      bytes += sent;
+   }
+
+   client.out.clear();
+   client.outPos = 0;
+}
+
+F12020StreamServer::F12020StreamServer()
+{
+   m_state = new State();
+}
+
+F12020StreamServer::~F12020StreamServer()
+{
+   Stop();
+   delete m_state;
+}
+
+bool F12020StreamServer::Start(uint16_t port, const char* bindAddr)
+{
+   Stop();
+
+#ifdef _WIN32
+   WSADATA wsa;
+   if (WSAStartup(MAKEWORD(2, 2), &wsa))
+      return false;
+#endif
+
+   Socket s = socket(AF_INET, SOCK_STREAM, 0);
+   if (s == NO_SOCKET)
+      return false;
+
+   int on = 1;
+   setsockopt(s, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&on), sizeof(on));
+
+   sockaddr_in addr{};
+   addr.sin_family = AF_INET;
+   addr.sin_port = htons(port);
+   addr.sin_addr.s_addr = htonl(INADDR_ANY);
+   socklen_t addrLen = sizeof(addr);
+   if ((bindAddr && (inet_pton(AF_INET, bindAddr, &addr.sin_addr) != 1)) ||
+      (bind(s, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) || (listen(s, 8) < 0) || !SetNonBlocking(s) ||
+      (getsockname(s, reinterpret_cast<sockaddr*>(&addr), &addrLen) < 0))
+   {
+      CloseSocket(s);
+#ifdef _WIN32
+      WSACleanup();
+#endif
+      return false;
+   }
+
+   m_state->listener = s;
+   m_state->port = ntohs(addr.sin_port);
+   m_state->stop.store(false);
+   m_state->running.store(true);
+   m_state->thread = std::thread([this]() { m_state->Run(); });
+   return true;
+}
+
+void F12020StreamServer::Stop()
+{
+   if (!m_state->running.load())
+      return;
+
+   m_state->stop.store(true);
+   m_state->thread.join();
+   CloseSocket(m_state->listener);
+   m_state->listener = NO_SOCKET;
+   m_state->port = 0;
+   m_state->running.store(false);
+#ifdef _WIN32
+   WSACleanup();
+#endif
+}
+
+bool F12020StreamServer::Running() const
+{
+   return m_state->running.load();
+}
+
+uint16_t F12020StreamServer::Port() const
+{
+   return m_state->port;
+}
+
+void F12020StreamServer::Publish(const F12020SharedState& state)
+{
+   const uint8_t* image = reinterpret_cast<const uint8_t*>(&state) + sizeof(F12020SharedStateHeader);
+
+   std::lock_guard<std::mutex> lock(m_state->mutex);
+   if (m_state->version && !memcmp(m_state->latest.data(), image, F12020_STREAM_IMAGE_SIZE))
+      return;
+
+   memcpy(m_state->latest.data(), image, F12020_STREAM_IMAGE_SIZE);
+   if (!++m_state->version)
+      m_state->version = 1; // 0 means none
+}
+
+F12020StreamStats F12020StreamServer::Stats() const
+{
+   F12020StreamStats stats;
+   stats.clients = m_state->connected.load();
+   stats.snapshots = m_state->snapshots.load();
+   stats.deltas = m_state->deltas.load();
+   stats.bytes = m_state->bytes.load();
+   return stats;
+}
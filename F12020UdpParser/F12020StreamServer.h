@@ -0,0 +1,105 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+#include <stdint.h>
+#include "F12020SharedState.h"
+
+// Streams the derived state to clients on other machines (e.g. overlays which cannot run the WPF board),
+// over plain TCP or WebSocket on the same port.
+// The state is the record image of F12020SharedState, i.e. session, car and event records without the header
+// (F12020_STREAM_IMAGE_SIZE bytes, see F12020SharedState.h). A client gets a snapshot of the complete image first,
+// afterwards deltas with the 32 bit words which changed since the version it acknowledged last. Each client has at
+// most one message unacknowledged and is served at its own rate, so a slow client gets fewer and larger deltas instead
+// of a growing queue, and the bandwidth and the encoding cost follow the changes, not the number of cars and fields.
+// Protocol (little endian, packed):
+//   TCP: every message is preceded by its size (uint32). WebSocket: one binary frame per message, the connection is
+//   a WebSocket if it starts with an HTTP GET (upgrade request).
+//   client: F12020StreamRequest HELLO first (sets the rate), F12020StreamAck for every snapshot and delta,
+//           HELLO again to change the rate, RESYNC for a new snapshot
+//   server: F12020StreamSnapshot + image, F12020StreamDelta + runs (F12020StreamRun + words * 4 bytes each)
+// The implementation is native only (<thread> is not available with /clr), the header is safe for managed code.
+
+constexpr uint32_t F12020_STREAM_IMAGE_SIZE = sizeof(F12020SharedState) - sizeof(F12020SharedStateHeader);
+constexpr unsigned F12020_STREAM_MAX_RATE = 60; // messages per second
+constexpr unsigned F12020_STREAM_MAX_CLIENTS = 32;
+
+enum F12020StreamMessageType : uint8_t
+{
+   F12020_STREAM_SNAPSHOT = 1,
+   F12020_STREAM_DELTA = 2,
+   F12020_STREAM_HELLO = 16,
+   F12020_STREAM_ACK = 17,
+   F12020_STREAM_RESYNC = 18
+};
+
+#pragma pack(push, 1)
+struct F12020StreamSnapshot
+{
+   uint8_t type;     // F12020_STREAM_SNAPSHOT
+   uint8_t layout;   // F12020_SHARED_STATE_VERSION
+   uint16_t reserved;
+   uint32_t version;
+   uint32_t size;    // image bytes following, F12020_STREAM_IMAGE_SIZE
+};
+
+struct F12020StreamDelta
+{
+   uint8_t type;     // F12020_STREAM_DELTA
+   uint8_t reserved;
+   uint16_t runs;    // F12020StreamRun following
+   uint32_t base;    // the acknowledged version the delta applies to
+   uint32_t version;
+};
+
+struct F12020StreamRun
+{
+   uint16_t offset;  // in words from the start of the image
+   uint16_t words;   // words following
+};
+
+struct F12020StreamRequest
+{
+   uint8_t type;     // F12020_STREAM_HELLO or F12020_STREAM_RESYNC
+   uint8_t rate;     // messages per second, 1 .. F12020_STREAM_MAX_RATE
+   uint16_t reserved;
+};
+
+struct F12020StreamAck
+{
+   uint8_t type;     // F12020_STREAM_ACK
+   uint8_t reserved[3];
+   uint32_t version;
+};
+#pragma pack(pop)
+
+struct F12020StreamStats
+{
+   unsigned clients;   // connected now
+   uint64_t snapshots;
+   uint64_t deltas;
+   uint64_t bytes;     // sent, incl. framing
+};
+
+struct F12020StreamServer
+{
+   F12020StreamServer();
+   ~F12020StreamServer();
+   F12020StreamServer(const F12020StreamServer&) = delete;
+   F12020StreamServer& operator=(const F12020StreamServer&) = delete;
+
+   // listen on bindAddr:port (nullptr = any address) and serve the clients on a thread of its own, false on error
+   bool Start(uint16_t port, const char* bindAddr = nullptr);
+   void Stop(); // disconnects all clients
+   bool Running() const;
+   uint16_t Port() const; // the bound port, useful with port 0
+
+   // any thread: the new state for the clients, a new version if the records changed (see F12020SharedState::Capture)
+   void Publish(const F12020SharedState& state);
+
+   F12020StreamStats Stats() const;
+
+private:
+   struct State;
+   State* m_state;
+};
@@ -0,0 +1,205 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "F12020UdpReceiver.h"
+#include "F12020UdpRelay.h"
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace
+{
+   constexpr int RECEIVE_BUFFER_SIZE = 4 * 1024 * 1024; // several game instances at 60 Hz
+   constexpr size_t CONTROL_SIZE = CMSG_SPACE(sizeof(timespec));
+
+   int64_t KernelTimestamp(msghdr& hdr)
+   {
+      for (cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr); cmsg; cmsg = CMSG_NXTHDR(&hdr, cmsg))
+      {
+         if ((cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SCM_TIMESTAMPNS))
+         {
+            timespec ts;
+            memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+            return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+         }
+      }
+      return 0;
+   }
+}
+
+F12020UdpReceiver::F12020UdpReceiver()
+{
+   m_buffers = new uint8_t[F12020_RECEIVER_BATCH * F12020_RING_SLOT_SIZE];
+   m_stopEvent = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+}
+
+F12020UdpReceiver::~F12020UdpReceiver()
+{
+   Close();
+   if (m_stopEvent >= 0)
+      close(m_stopEvent);
+   delete[] m_buffers;
+}
+
+bool F12020UdpReceiver::Open(uint16_t port, const char* bindAddr)
+{
+   Close();
+   if (m_stopEvent < 0)
+      return false;
+
+   m_socket = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+   if (m_socket < 0)
+      return false;
+
+   int on = 1;
+   int rcvBuf = RECEIVE_BUFFER_SIZE;
+   setsockopt(m_socket, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+   setsockopt(m_socket, SOL_SOCKET, SO_RCVBUF, &rcvBuf, sizeof(rcvBuf)); // best effort, limited by net.core.rmem_max
+   setsockopt(m_socket, SOL_SOCKET, SO_TIMESTAMPNS, &on, sizeof(on));
+
+   sockaddr_in addr{};
+   addr.sin_family = AF_INET;
+   addr.sin_port = htons(port);
+   addr.sin_addr.s_addr = htonl(INADDR_ANY);
+   if (bindAddr && (inet_pton(AF_INET, bindAddr, &addr.sin_addr) != 1))
+   {
+      Close();
+      errno = EINVAL;
+      return false;
+   }
+
+   if (bind(m_socket, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0)
+   {
+      int err = errno;
+      Close();
+      errno = err;
+      return false;
+   }
+
+   socklen_t addrLen = sizeof(addr);
+   getsockname(m_socket, reinterpret_cast<sockaddr*>(&addr), &addrLen);
+   m_port = ntohs(addr.sin_port);
+   return true;
+}
+
+void F12020UdpReceiver::Close()
+{
+   if (m_socket >= 0)
+      close(m_socket);
+   m_socket = -1;
+   m_port = 0;
+}
+
+bool F12020UdpReceiver::Run(const Sink& sink)
+{
+   if (m_socket < 0)
+      return false;
+
+   mmsghdr msgs[F12020_RECEIVER_BATCH];
+   iovec iovs[F12020_RECEIVER_BATCH];
+   sockaddr_in senders[F12020_RECEIVER_BATCH];
+   F12020ReceivedPacket packets[F12020_RECEIVER_BATCH];
+   alignas(cmsghdr) uint8_t control[F12020_RECEIVER_BATCH][CONTROL_SIZE];
+
+   pollfd fds[2];
+   fds[0].fd = m_stopEvent;
+   fds[0].events = POLLIN;
+   fds[1].fd = m_socket;
+   fds[1].events = POLLIN;
+
+   for (;;)
+   {
+      fds[0].revents = fds[1].revents = 0;
+      if (poll(fds, 2, -1) < 0)
+      {
+         if (errno == EINTR)
+            continue;
+         return false;
+      }
+
+      if (fds[0].revents)
+      {
+         uint64_t value;
+         while (read(m_stopEvent, &value, sizeof(value)) > 0) // rearm for the next Run()
+            ;
+         return true;
+      }
+
+      if (fds[1].revents & (POLLERR | POLLNVAL))
+         return false;
+
+      // drain the socket, then poll again
+      for (;;)
+      {
+         for (unsigned i = 0; i < F12020_RECEIVER_BATCH; ++i)
+         {
+            iovs[i].iov_base = m_buffers + i * F12020_RING_SLOT_SIZE;
+            iovs[i].iov_len = F12020_RING_SLOT_SIZE;
+            msgs[i].msg_hdr = msghdr{};
+            msgs[i].msg_hdr.msg_iov = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            msgs[i].msg_hdr.msg_name = &senders[i];
+            msgs[i].msg_hdr.msg_namelen = sizeof(senders[i]);
+            msgs[i].msg_hdr.msg_control = control[i];
+            msgs[i].msg_hdr.msg_controllen = CONTROL_SIZE;
+            msgs[i].msg_len = 0;
+         }
+
+         int received = recvmmsg(m_socket, msgs, F12020_RECEIVER_BATCH, MSG_DONTWAIT, nullptr);
+         if (received < 0)
+         {
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+               break;
+            if (errno == EINTR)
+               continue;
+            return false;
+         }
+
+         ++m_stats.batches;
+         unsigned count = 0;
+         for (int i = 0; i < received; ++i)
+         {
+            ++m_stats.datagrams;
+            if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC)
+            {
+               ++m_stats.truncated;
+               continue;
+            }
+
+            F12020ReceivedPacket& packet = packets[count++];
+            packet.data = static_cast<const uint8_t*>(iovs[i].iov_base);
+            packet.len = msgs[i].msg_len;
+            packet.timestampNs = KernelTimestamp(msgs[i].msg_hdr);
+            packet.source = (static_cast<uint64_t>(ntohl(senders[i].sin_addr.s_addr)) << 16) | ntohs(senders[i].sin_port);
+         }
+
+         // relayed first, the downstream tools should not wait for the parsing
+         if (m_relay)
+            m_relay->Forward(packets, count);
+         for (unsigned i = 0; i < count; ++i)
+            sink(packets[i]);
+
+         if (received < static_cast<int>(F12020_RECEIVER_BATCH))
+            break;
+      }
+   }
+}
+
+void F12020UdpReceiver::Stop()
+{
+   if (m_stopEvent >= 0)
+   {
+      uint64_t one = 1;
+      ssize_t written = write(m_stopEvent, &one, sizeof(one));
+      (void)written;
+   }
+}
+#endif
@@ -0,0 +1,68 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+#ifdef __linux__
+#include <stdint.h>
+#include <functional>
+#include "F12020PacketRing.h"
+
+// Native UDP ingest for headless Linux hosts.
+// Datagrams are received in batches with recvmmsg, each one carries the kernel receive timestamp (SO_TIMESTAMPNS).
+// Run() blocks until Stop() is called from another thread, which wakes the poll via an eventfd (no timeout polling).
+// The packets are handed to the sink in place, e.g. to F12020SessionEngine::ProceedPacket, and optionally to a
+// F12020UdpRelay which sends them on to further endpoints.
+
+constexpr unsigned F12020_RECEIVER_BATCH = 64;
+
+struct F12020UdpRelay;
+
+struct F12020ReceivedPacket
+{
+   const uint8_t* data; // valid during the sink call only
+   unsigned len;
+   int64_t timestampNs; // kernel receive time (CLOCK_REALTIME), 0 if not available
+   uint64_t source;     // sender IPv4 address << 16 | port
+};
+
+struct F12020ReceiverStats
+{
+   uint64_t datagrams;
+   uint64_t batches;   // recvmmsg calls which returned data
+   uint64_t truncated; // datagrams larger than F12020_RING_SLOT_SIZE, not delivered
+};
+
+struct F12020UdpReceiver
+{
+   typedef std::function<void(const F12020ReceivedPacket&)> Sink;
+
+   F12020UdpReceiver();
+   ~F12020UdpReceiver();
+   F12020UdpReceiver(const F12020UdpReceiver&) = delete;
+   F12020UdpReceiver& operator=(const F12020UdpReceiver&) = delete;
+
+   // bind to bindAddr:port (nullptr = any address), false on error (see errno)
+   bool Open(uint16_t port, const char* bindAddr = nullptr);
+   void Close();
+
+   // receive until Stop(), false on socket error
+   bool Run(const Sink& sink);
+
+   // thread safe, may be called before Run() as well
+   void Stop();
+
+   // forward every received batch to the destinations of relay (before the sink sees it), nullptr: none. Not during Run().
+   void SetRelay(F12020UdpRelay* relay) { m_relay = relay; }
+
+   F12020ReceiverStats Stats() const { return m_stats; } // only consistent from the Run() thread or after Run() returned
+   uint16_t Port() const { return m_port; } // the bound port, useful with port 0
+
+private:
+   int m_socket{ -1 };
+   int m_stopEvent{ -1 };
+   uint16_t m_port{ 0 };
+   F12020ReceiverStats m_stats{};
+   uint8_t* m_buffers{ nullptr }; // F12020_RECEIVER_BATCH slots of F12020_RING_SLOT_SIZE
+   F12020UdpRelay* m_relay{ nullptr };
+};
+#endif
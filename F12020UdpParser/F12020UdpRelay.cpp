@@ -0,0 +1,193 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "F12020UdpRelay.h"
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <errno.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include "F12020ElementaryParser.h"
+
+namespace
+{
+   constexpr int SEND_BUFFER_SIZE = 4 * 1024 * 1024; // one receive batch to every destination
+   constexpr unsigned MAX_MESSAGES = F12020_RECEIVER_BATCH * F12020_RELAY_MAX_DESTINATIONS;
+   constexpr double BURST_SECONDS = 0.1;
+
+   int64_t MonotonicNow()
+   {
+      timespec ts;
+      clock_gettime(CLOCK_MONOTONIC, &ts);
+      return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+   }
+}
+
+bool F12020RelayDestination::Parse(const char* spec)
+{
+   const char* colon = strchr(spec, ':');
+   if (!colon || (colon - spec >= INET_ADDRSTRLEN))
+      return false;
+
+   char host[INET_ADDRSTRLEN];
+   memcpy(host, spec, colon - spec);
+   host[colon - spec] = 0;
+
+   address = sockaddr_in{};
+   address.sin_family = AF_INET;
+   if (inet_pton(AF_INET, host, &address.sin_addr) != 1)
+      return false;
+
+   char* end;
+   unsigned long port = strtoul(colon + 1, &end, 10);
+   if ((end == colon + 1) || !port || (port > 0xffff))
+      return false;
+   address.sin_port = htons(static_cast<uint16_t>(port));
+
+   packets = F12020_RELAY_ALL;
+   if (*end == '/')
+   {
+      packets = 0;
+      do
+      {
+         const char* id = end + 1;
+         unsigned long packetId = strtoul(id, &end, 10);
+         if ((end == id) || (packetId > 31))
+            return false;
+         packets |= F12020PacketBit(static_cast<uint8_t>(packetId));
+      } while (*end == ',');
+   }
+
+   maxRate = 0;
+   if (*end == '@')
+   {
+      const char* rate = end + 1;
+      maxRate = static_cast<unsigned>(strtoul(rate, &end, 10));
+      if (end == rate)
+         return false;
+   }
+
+   return *end == 0;
+}
+
+F12020UdpRelay::F12020UdpRelay()
+{
+   m_msgs = new mmsghdr[MAX_MESSAGES];
+   m_iovs = new iovec[MAX_MESSAGES];
+   m_targets = new uint8_t[MAX_MESSAGES];
+
+   m_socket = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+   if (m_socket >= 0)
+   {
+      int sndBuf = SEND_BUFFER_SIZE;
+      setsockopt(m_socket, SOL_SOCKET, SO_SNDBUF, &sndBuf, sizeof(sndBuf)); // best effort, limited by net.core.wmem_max
+   }
+}
+
+F12020UdpRelay::~F12020UdpRelay()
+{
+   if (m_socket >= 0)
+      close(m_socket);
+   delete[] m_targets;
+   delete[] m_iovs;
+   delete[] m_msgs;
+}
+
+bool F12020UdpRelay::AddDestination(const F12020RelayDestination& destination)
+{
+   if ((m_socket < 0) || (m_count >= F12020_RELAY_MAX_DESTINATIONS))
+      return false;
+
+   Destination& d = m_destinations[m_count++];
+   d.config = destination;
+   d.stats = F12020RelayStats{};
+   d.tokens = std::max(destination.maxRate * BURST_SECONDS, 1.0);
+   d.lastNs = MonotonicNow();
+   return true;
+}
+
+bool F12020UdpRelay::m_Pass(Destination& destination, const F12020ReceivedPacket& packet, int64_t nowNs)
+{
+   const F12020RelayDestination& config = destination.config;
+   if (config.packets != F12020_RELAY_ALL)
+   {
+      const uint8_t packetId = (packet.len >= sizeof(PacketHeader)) ? reinterpret_cast<const PacketHeader*>(packet.data)->m_packetId : 0xff;
+      if ((packetId > 31) || !(config.packets & F12020PacketBit(packetId)))
+      {
+         ++destination.stats.filtered;
+         return false;
+      }
+   }
+
+   if (config.maxRate)
+   {
+      const double burst = std::max(config.maxRate * BURST_SECONDS, 1.0);
+      destination.tokens = std::min(destination.tokens + (nowNs - destination.lastNs) * 1e-9 * config.maxRate, burst);
+      destination.lastNs = nowNs;
+      if (destination.tokens < 1.0)
+      {
+         ++destination.stats.limited;
+         return false;
+      }
+      destination.tokens -= 1.0;
+   }
+
+   return true;
+}
+
+void F12020UdpRelay::Forward(const F12020ReceivedPacket* packets, unsigned count)
+{
+   if (!m_count)
+      return;
+
+   // datagram by datagram, so each destination gets the packets in the order received
+   const int64_t nowNs = MonotonicNow();
+   unsigned messages = 0;
+   for (unsigned i = 0; i < std::min(count, F12020_RECEIVER_BATCH); ++i)
+   {
+      for (unsigned j = 0; j < m_count; ++j)
+      {
+         Destination& destination = m_destinations[j];
+         if (!m_Pass(destination, packets[i], nowNs))
+            continue;
+
+         iovec& iov = m_iovs[messages];
+         iov.iov_base = const_cast<uint8_t*>(packets[i].data);
+         iov.iov_len = packets[i].len;
+
+         mmsghdr& msg = m_msgs[messages];
+         msg.msg_hdr = msghdr{};
+         msg.msg_hdr.msg_iov = &iov;
+         msg.msg_hdr.msg_iovlen = 1;
+         msg.msg_hdr.msg_name = &destination.config.address;
+         msg.msg_hdr.msg_namelen = sizeof(destination.config.address);
+         msg.msg_len = 0;
+         m_targets[messages++] = static_cast<uint8_t>(j);
+      }
+   }
+
+   unsigned done = 0;
+   while (done < messages)
+   {
+      int sent = sendmmsg(m_socket, m_msgs + done, messages - done, MSG_DONTWAIT);
+      if (sent < 0)
+      {
+         if (errno == EINTR)
+            continue;
+
+         // the first message of the rest failed (full send buffer, unreachable host), skip it and go on with the others
+         ++m_destinations[m_targets[done++]].stats.failed;
+         continue;
+      }
+
+      for (int k = 0; k < sent; ++k)
+         ++m_destinations[m_targets[done++]].stats.sent;
+   }
+}
+#endif
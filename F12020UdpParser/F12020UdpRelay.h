@@ -0,0 +1,77 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+#ifdef __linux__
+#include <stdint.h>
+#include <netinet/in.h>
+#include "F12020UdpReceiver.h"
+
+// Fan-out of the received datagrams to further local or remote endpoints, since the game sends to one port only:
+// a logger, the board and third party tools all run off one game instance behind one F12020UdpReceiver.
+// The datagrams of a receive batch are sent in place (no copy) with one sendmmsg call for all destinations.
+// Each destination forwards a subset of the packet ids and may be rate limited (token bucket, bursts of up to
+// 1/10 s worth of packets), packets over the limit are dropped for that destination only.
+// Sending never blocks the ingest, a datagram the socket does not take right away is counted as failed.
+// Linux only like F12020UdpReceiver (sendmmsg), the Windows build compiles it empty. It runs headless in
+// "F12020UdpIngest listen --relay", which feeds e.g. the board on a Windows machine from the Linux host the game sends to.
+
+constexpr unsigned F12020_RELAY_MAX_DESTINATIONS = 8;
+constexpr uint32_t F12020_RELAY_ALL = ~0u; // forward every datagram, also those which are no F1 packet
+
+struct F12020RelayDestination
+{
+   sockaddr_in address;
+   uint32_t packets{ F12020_RELAY_ALL }; // packet ids to forward, see F12020PacketBit
+   unsigned maxRate{ 0 };                // packets per second, 0: unlimited
+
+   // "address:port[/id,id,...][@rate]", e.g. "127.0.0.1:20778/1,2,4@60" (session, lap data and participants, at most 60/s)
+   bool Parse(const char* spec);
+};
+
+struct F12020RelayStats
+{
+   uint64_t sent;
+   uint64_t filtered; // packet id not forwarded to the destination
+   uint64_t limited;  // over the rate limit
+   uint64_t failed;   // rejected by the socket, e.g. the send buffer was full
+};
+
+struct F12020UdpRelay
+{
+   F12020UdpRelay();
+   ~F12020UdpRelay();
+   F12020UdpRelay(const F12020UdpRelay&) = delete;
+   F12020UdpRelay& operator=(const F12020UdpRelay&) = delete;
+
+   // the destinations are fixed while the receiver runs, false if there are F12020_RELAY_MAX_DESTINATIONS already
+   bool AddDestination(const F12020RelayDestination& destination);
+   unsigned Destinations() const { return m_count; }
+
+   // receive thread: send the datagrams of one batch (at most F12020_RECEIVER_BATCH) to all destinations,
+   // the packet data must stay valid during the call only
+   void Forward(const F12020ReceivedPacket* packets, unsigned count);
+
+   F12020RelayStats Stats(unsigned destination) const { return m_destinations[destination].stats; } // see F12020UdpReceiver::Stats
+
+private:
+   struct Destination
+   {
+      F12020RelayDestination config;
+      F12020RelayStats stats;
+      double tokens;  // rate limit: packets which may be sent now
+      int64_t lastNs; // time of the last refill
+   };
+
+   bool m_Pass(Destination& destination, const F12020ReceivedPacket& packet, int64_t nowNs);
+
+   int m_socket{ -1 };
+   unsigned m_count{ 0 };
+   Destination m_destinations[F12020_RELAY_MAX_DESTINATIONS];
+
+   // one message per datagram and destination, allocated once
+   struct mmsghdr* m_msgs;
+   struct iovec* m_iovs;
+   uint8_t* m_targets; // destination index of each message
+};
+#endif
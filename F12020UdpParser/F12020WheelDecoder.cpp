@@ -0,0 +1,259 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "F12020WheelDecoder.h"
+
+#include <string.h>
+#if F12020_WHEEL_DECODER_SSE2
+#include <emmintrin.h>
+#endif
+#if F12020_WHEEL_DECODER_AVX2
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define F12020_AVX2_FUNCTION
+#else
+#define F12020_AVX2_FUNCTION __attribute__((target("avx2"))) // the rest of the file stays SSE2
+#endif
+#endif
+
+#ifdef _MANAGED
+#pragma managed(push, off)
+#endif
+
+namespace
+{
+   // packet wheel index for each display wheel
+   constexpr int s_wheelSrc[F12020_WHEELS] = { 2, 3, 0, 1 };
+
+   template<typename Dst, typename Src>
+   void DecodeScalar(Dst(&dst)[F12020_WHEELS][F12020_MAX_CARS], const uint8_t* src, size_t stride, int firstCar)
+   {
+      for (int i = firstCar; i < F12020_MAX_CARS; ++i)
+      {
+         Src wheels[F12020_WHEELS];
+         memcpy(wheels, src + i * stride, sizeof(wheels));
+         for (int w = 0; w < F12020_WHEELS; ++w)
+            dst[w][i] = wheels[s_wheelSrc[w]];
+      }
+   }
+
+#if F12020_WHEEL_DECODER_SSE2
+   // load the 4 uint8 wheels of 4 cars and transpose to 4 x 32 bit lanes in display order: FL[car0..3], FR, RL, RR
+   __m128i Load8(const uint8_t* src, size_t stride, int car)
+   {
+      int32_t w[4];
+      for (int k = 0; k < 4; ++k)
+         memcpy(&w[k], src + (car + k) * stride, sizeof(int32_t));
+
+      __m128i ab = _mm_unpacklo_epi8(_mm_cvtsi32_si128(w[0]), _mm_cvtsi32_si128(w[1]));
+      __m128i cd = _mm_unpacklo_epi8(_mm_cvtsi32_si128(w[2]), _mm_cvtsi32_si128(w[3]));
+      __m128i packetOrder = _mm_unpacklo_epi16(ab, cd); // RL, RR, FL, FR
+      return _mm_shuffle_epi32(packetOrder, _MM_SHUFFLE(1, 0, 3, 2));
+   }
+#endif
+
+#if F12020_WHEEL_DECODER_AVX2
+   constexpr int s_avx2Cars = F12020_MAX_CARS & ~7; // cars decoded 8 at a time, the rest by SSE2 and scalar
+
+   bool CpuHasAvx2()
+   {
+#ifdef _MSC_VER
+      int info[4];
+      __cpuid(info, 0);
+      if (info[0] < 7)
+         return false;
+
+      __cpuid(info, 1);
+      const int osxsaveAvx = (1 << 27) | (1 << 28);
+      if (((info[2] & osxsaveAvx) != osxsaveAvx) || ((_xgetbv(0) & 6) != 6)) // the OS saves the ymm registers
+         return false;
+
+      __cpuidex(info, 7, 0);
+      return (info[1] & (1 << 5)) != 0;
+#else
+      __builtin_cpu_init(); // s_avx2 may be initialized before the constructor of libgcc which does this
+      return __builtin_cpu_supports("avx2");
+#endif
+   }
+
+   const bool s_avx2 = CpuHasAvx2();
+
+   // byte offsets of 8 consecutive cars, for the gathers in Load8Avx2
+   F12020_AVX2_FUNCTION __m256i CarOffsets(size_t stride)
+   {
+      return _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(static_cast<int>(stride)));
+   }
+
+   // load the 4 uint8 wheels of 8 cars, display order in 64 bit lanes: FL[car0..7], FR, RL, RR
+   F12020_AVX2_FUNCTION __m256i Load8Avx2(const uint8_t* src, __m256i offsets, int car, size_t stride)
+   {
+      // one gather instead of 8 scalar loads, which would stall when reloaded as one vector
+      __m256i packetOrder = _mm256_i32gather_epi32(reinterpret_cast<const int*>(src + car * stride), offsets, 1);
+
+      // per 128 bit half (cars 0..3, 4..7): the byte of wheel s_wheelSrc[w] of car k to w * 4 + k
+      const __m256i transpose = _mm256_setr_epi8(
+         2, 6, 10, 14, 3, 7, 11, 15, 0, 4, 8, 12, 1, 5, 9, 13,
+         2, 6, 10, 14, 3, 7, 11, 15, 0, 4, 8, 12, 1, 5, 9, 13);
+      __m256i halves = _mm256_shuffle_epi8(packetOrder, transpose);
+      return _mm256_permutevar8x32_epi32(halves, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+   }
+
+   F12020_AVX2_FUNCTION int Decode8Avx2(F12020WheelsU8& dst, const uint8_t* src, size_t stride)
+   {
+      const __m256i offsets = CarOffsets(stride);
+      for (int i = 0; i < s_avx2Cars; i += 8)
+      {
+         __m256i wheels = Load8Avx2(src, offsets, i, stride);
+         __m128i front = _mm256_castsi256_si128(wheels);
+         __m128i rear = _mm256_extracti128_si256(wheels, 1);
+         _mm_storel_epi64(reinterpret_cast<__m128i*>(&dst[F12020_WHEEL_FL][i]), front);
+         _mm_storel_epi64(reinterpret_cast<__m128i*>(&dst[F12020_WHEEL_FR][i]), _mm_srli_si128(front, 8));
+         _mm_storel_epi64(reinterpret_cast<__m128i*>(&dst[F12020_WHEEL_RL][i]), rear);
+         _mm_storel_epi64(reinterpret_cast<__m128i*>(&dst[F12020_WHEEL_RR][i]), _mm_srli_si128(rear, 8));
+      }
+      return s_avx2Cars;
+   }
+
+   F12020_AVX2_FUNCTION int Decode8To16Avx2(F12020WheelsU16& dst, const uint8_t* src, size_t stride)
+   {
+      const __m256i offsets = CarOffsets(stride);
+      for (int i = 0; i < s_avx2Cars; i += 8)
+      {
+         __m256i wheels = Load8Avx2(src, offsets, i, stride);
+         __m256i front = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(wheels));     // FL, FR
+         __m256i rear = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(wheels, 1)); // RL, RR
+         _mm_storeu_si128(reinterpret_cast<__m128i*>(&dst[F12020_WHEEL_FL][i]), _mm256_castsi256_si128(front));
+         _mm_storeu_si128(reinterpret_cast<__m128i*>(&dst[F12020_WHEEL_FR][i]), _mm256_extracti128_si256(front, 1));
+         _mm_storeu_si128(reinterpret_cast<__m128i*>(&dst[F12020_WHEEL_RL][i]), _mm256_castsi256_si128(rear));
+         _mm_storeu_si128(reinterpret_cast<__m128i*>(&dst[F12020_WHEEL_RR][i]), _mm256_extracti128_si256(rear, 1));
+      }
+      return s_avx2Cars;
+   }
+
+   F12020_AVX2_FUNCTION int Decode16Avx2(F12020WheelsU16& dst, const uint8_t* src, size_t stride)
+   {
+      for (int i = 0; i < s_avx2Cars; i += 8)
+      {
+         // car k in the lower, car k + 4 in the upper 128 bit half, the unpacks below work per half
+         __m256i car[4];
+         for (int k = 0; k < 4; ++k)
+         {
+            __m128i lo = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + (i + k) * stride));
+            __m128i hi = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + (i + k + 4) * stride));
+            car[k] = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+         }
+
+         __m256i ab = _mm256_unpacklo_epi16(car[0], car[1]);
+         __m256i cd = _mm256_unpacklo_epi16(car[2], car[3]);
+         __m256i rear = _mm256_permute4x64_epi64(_mm256_unpacklo_epi32(ab, cd), _MM_SHUFFLE(3, 1, 2, 0));  // RL, RR
+         __m256i front = _mm256_permute4x64_epi64(_mm256_unpackhi_epi32(ab, cd), _MM_SHUFFLE(3, 1, 2, 0)); // FL, FR
+         _mm_storeu_si128(reinterpret_cast<__m128i*>(&dst[F12020_WHEEL_FL][i]), _mm256_castsi256_si128(front));
+         _mm_storeu_si128(reinterpret_cast<__m128i*>(&dst[F12020_WHEEL_FR][i]), _mm256_extracti128_si256(front, 1));
+         _mm_storeu_si128(reinterpret_cast<__m128i*>(&dst[F12020_WHEEL_RL][i]), _mm256_castsi256_si128(rear));
+         _mm_storeu_si128(reinterpret_cast<__m128i*>(&dst[F12020_WHEEL_RR][i]), _mm256_extracti128_si256(rear, 1));
+      }
+      return s_avx2Cars;
+   }
+#endif
+}
+
+const char* F12020WheelDecoderIsa()
+{
+#if F12020_WHEEL_DECODER_AVX2
+   if (s_avx2)
+      return "avx2";
+#endif
+   return F12020_WHEEL_DECODER_SSE2 ? "sse2" : "scalar";
+}
+
+void F12020DecodeWheels8(F12020WheelsU8& dst, const uint8_t* src, size_t stride)
+{
+   int i = 0;
+#if F12020_WHEEL_DECODER_AVX2
+   if (s_avx2)
+      i = Decode8Avx2(dst, src, stride);
+#endif
+#if F12020_WHEEL_DECODER_SSE2
+   for (; i + 4 <= F12020_MAX_CARS; i += 4)
+   {
+      __m128i wheels = Load8(src, stride, i);
+      for (int w = 0; w < F12020_WHEELS; ++w)
+      {
+         int32_t lane = _mm_cvtsi128_si32(wheels);
+         memcpy(&dst[w][i], &lane, sizeof(lane));
+         wheels = _mm_srli_si128(wheels, 4);
+      }
+   }
+#endif
+   DecodeScalar<uint8_t, uint8_t>(dst, src, stride, i);
+}
+
+void F12020DecodeWheels8Scalar(F12020WheelsU8& dst, const uint8_t* src, size_t stride)
+{
+   DecodeScalar<uint8_t, uint8_t>(dst, src, stride, 0);
+}
+
+void F12020DecodeWheels8To16(F12020WheelsU16& dst, const uint8_t* src, size_t stride)
+{
+   int i = 0;
+#if F12020_WHEEL_DECODER_AVX2
+   if (s_avx2)
+      i = Decode8To16Avx2(dst, src, stride);
+#endif
+#if F12020_WHEEL_DECODER_SSE2
+   const __m128i zero = _mm_setzero_si128();
+   for (; i + 4 <= F12020_MAX_CARS; i += 4)
+   {
+      __m128i wheels = Load8(src, stride, i);
+      __m128i front = _mm_unpacklo_epi8(wheels, zero); // FL, FR
+      __m128i rear = _mm_unpackhi_epi8(wheels, zero);  // RL, RR
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(&dst[F12020_WHEEL_FL][i]), front);
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(&dst[F12020_WHEEL_FR][i]), _mm_srli_si128(front, 8));
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(&dst[F12020_WHEEL_RL][i]), rear);
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(&dst[F12020_WHEEL_RR][i]), _mm_srli_si128(rear, 8));
+   }
+#endif
+   DecodeScalar<uint16_t, uint8_t>(dst, src, stride, i);
+}
+
+void F12020DecodeWheels8To16Scalar(F12020WheelsU16& dst, const uint8_t* src, size_t stride)
+{
+   DecodeScalar<uint16_t, uint8_t>(dst, src, stride, 0);
+}
+
+void F12020DecodeWheels16(F12020WheelsU16& dst, const uint8_t* src, size_t stride)
+{
+   int i = 0;
+#if F12020_WHEEL_DECODER_AVX2
+   if (s_avx2)
+      i = Decode16Avx2(dst, src, stride);
+#endif
+#if F12020_WHEEL_DECODER_SSE2
+   for (; i + 4 <= F12020_MAX_CARS; i += 4)
+   {
+      __m128i car[4];
+      for (int k = 0; k < 4; ++k)
+         car[k] = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + (i + k) * stride));
+
+      __m128i ab = _mm_unpacklo_epi16(car[0], car[1]);
+      __m128i cd = _mm_unpacklo_epi16(car[2], car[3]);
+      __m128i rear = _mm_unpacklo_epi32(ab, cd);  // RL, RR
+      __m128i front = _mm_unpackhi_epi32(ab, cd); // FL, FR
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(&dst[F12020_WHEEL_FL][i]), front);
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(&dst[F12020_WHEEL_FR][i]), _mm_srli_si128(front, 8));
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(&dst[F12020_WHEEL_RL][i]), rear);
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(&dst[F12020_WHEEL_RR][i]), _mm_srli_si128(rear, 8));
+   }
+#endif
+   DecodeScalar<uint16_t, uint16_t>(dst, src, stride, i);
+}
+
+void F12020DecodeWheels16Scalar(F12020WheelsU16& dst, const uint8_t* src, size_t stride)
+{
+   DecodeScalar<uint16_t, uint16_t>(dst, src, stride, 0);
+}
+
+#ifdef _MANAGED
+#pragma managed(pop)
+#endif
@@ -0,0 +1,43 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "F12020CarStateStore.h"
+
+// Batch decoders for the per car wheel arrays of the telemetry and status packets.
+// src points to the wheel array of the first car, stride is the size of one car entry.
+// The packet wheel order RL, RR, FL, FR is reordered to F12020Wheel and transposed to [wheel][car].
+// With AVX2 (chosen at runtime, if the CPU has it) eight cars are decoded per step, with SSE2 four,
+// the remaining cars one by one. The Scalar variants are the per field reference.
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)) || defined(__SSE2__)
+#define F12020_WHEEL_DECODER_SSE2 1
+#else
+#define F12020_WHEEL_DECODER_SSE2 0
+#endif
+
+#if defined(_M_X64) || (defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)))
+#define F12020_WHEEL_DECODER_AVX2 1
+#else
+#define F12020_WHEEL_DECODER_AVX2 0
+#endif
+
+// instruction set the batch decoders use on this CPU: "avx2", "sse2" or "scalar"
+const char* F12020WheelDecoderIsa();
+
+typedef uint8_t F12020WheelsU8[F12020_WHEELS][F12020_MAX_CARS];
+typedef uint16_t F12020WheelsU16[F12020_WHEELS][F12020_MAX_CARS];
+
+// uint8 wheel arrays (wear, damage)
+void F12020DecodeWheels8(F12020WheelsU8& dst, const uint8_t* src, size_t stride);
+void F12020DecodeWheels8Scalar(F12020WheelsU8& dst, const uint8_t* src, size_t stride);
+
+// uint8 wheel arrays widened to uint16 (tyre temperatures)
+void F12020DecodeWheels8To16(F12020WheelsU16& dst, const uint8_t* src, size_t stride);
+void F12020DecodeWheels8To16Scalar(F12020WheelsU16& dst, const uint8_t* src, size_t stride);
+
+// uint16 wheel arrays (brake temperatures)
+void F12020DecodeWheels16(F12020WheelsU16& dst, const uint8_t* src, size_t stride);
+void F12020DecodeWheels16Scalar(F12020WheelsU16& dst, const uint8_t* src, size_t stride);
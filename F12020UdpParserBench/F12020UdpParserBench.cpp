@@ -0,0 +1,636 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+// Microbenchmarks of the native parser paths, meaningful only for Release builds.
+// usage: F12020UdpParserBench [iterations] [--json]
+// All inputs are synthetic and fixed, so the numbers are comparable between builds.
+// --json prints one JSON object with all results (ns per call) instead of the table, to track regressions.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "F12020DataDefs.h"
+#include "F12020DriverNameIndex.h"
+#include "F12020SessionEngine.h"
+#include "F12020ChangeTracker.h"
+#include "F12020StateSnapshot.h"
+#include "F12020WheelDecoder.h"
+
+namespace
+{
+   constexpr int PACKETS = 64; // rotate through some packets, so nothing is constant between the iterations
+   constexpr uint64_t SESSION_UID = 0x2020;
+   constexpr int PLAYER = 3;
+   constexpr int RACE = 10;
+   constexpr int Q1 = 5;
+   constexpr int RACE_LAPS = 200; // total laps of the synthetic session, beyond the former 100 lap limit
+
+   struct Result
+   {
+      std::string name;
+      double ns;
+   };
+
+   bool s_json = false;
+   std::vector<Result> s_results;
+   volatile size_t s_sink; // keeps results alive which are otherwise unused
+
+   void Report(const std::string& name, double ns)
+   {
+      s_results.push_back(Result{ name, ns });
+      if (!s_json)
+         printf("  %-32s %10.1f ns\n", name.c_str(), ns);
+   }
+
+   void Section(const char* title)
+   {
+      if (!s_json)
+         printf("%s\n", title);
+   }
+
+   // returns ns per call of fn(iteration)
+   template<typename Fn>
+   double Measure(Fn fn, int iterations)
+   {
+      for (int i = 0; i < iterations / 10; ++i) // warm up
+         fn(i);
+
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < iterations; ++i)
+         fn(i);
+      auto stop = std::chrono::steady_clock::now();
+
+      return std::chrono::duration<double, std::nano>(stop - start).count() / iterations;
+   }
+
+   template<typename Packet>
+   const uint8_t* Bytes(const Packet& packet, size_t offset = 0)
+   {
+      return reinterpret_cast<const uint8_t*>(&packet) + offset;
+   }
+
+   template<typename Packet>
+   std::vector<uint8_t> Buffer(const Packet& packet)
+   {
+      return std::vector<uint8_t>(Bytes(packet), Bytes(packet) + sizeof(packet));
+   }
+
+   PacketHeader Header(uint8_t packetId, float sessionTime, uint32_t frame)
+   {
+      PacketHeader header{};
+      header.m_packetFormat = 2020;
+      header.m_gameMajorVersion = 1;
+      header.m_packetVersion = 1;
+      header.m_packetId = packetId;
+      header.m_sessionUID = SESSION_UID;
+      header.m_sessionTime = sessionTime;
+      header.m_frameIdentifier = frame;
+      header.m_playerCarIndex = PLAYER;
+      header.m_secondaryPlayerCarIndex = 255;
+      return header;
+   }
+
+   void Randomize(void* p, size_t len, std::mt19937& rnd)
+   {
+      uint8_t* raw = static_cast<uint8_t*>(p);
+      for (size_t i = 0; i < len; ++i)
+         raw[i] = static_cast<uint8_t>(rnd());
+   }
+
+   // synthetic session: 22 cars, car i laps in 90 + i * 0.25 seconds, so the order never changes
+   struct SyntheticSession
+   {
+      int sessionType;
+      float time{ 0 };
+      uint32_t frame{ 0 };
+
+      static float SectorTime(int car, int sector) { return 30.0f + car * 0.25f / 3 + sector * 0.01f; }
+      static float LapTime(int car) { return SectorTime(car, 0) + SectorTime(car, 1) + SectorTime(car, 2); }
+
+      PacketSessionData Session()
+      {
+         PacketSessionData packet{};
+         packet.m_header = Header(1, time, frame);
+         packet.m_trackId = 7;
+         packet.m_sessionType = static_cast<uint8>(sessionType);
+         packet.m_totalLaps = RACE_LAPS;
+         packet.m_sessionTimeLeft = 7200;
+         return packet;
+      }
+
+      PacketParticipantsData Participants()
+      {
+         PacketParticipantsData packet{};
+         packet.m_header = Header(4, time, frame);
+         packet.m_numActiveCars = F12020_MAX_CARS;
+         for (int i = 0; i < F12020_MAX_CARS; ++i)
+         {
+            auto& p = packet.m_participants[i];
+            p.m_driverId = static_cast<uint8>(100 + i);
+            p.m_teamId = static_cast<uint8>(i / 2);
+            p.m_raceNumber = static_cast<uint8>(i + 2);
+            snprintf(p.m_name, sizeof(p.m_name), "Driver %d", i);
+         }
+         return packet;
+      }
+
+      PacketCarStatusData Status()
+      {
+         PacketCarStatusData packet{};
+         packet.m_header = Header(7, time, frame);
+         for (auto& car : packet.m_carStatusData)
+         {
+            car.m_actualTyreCompound = 18;
+            car.m_visualTyreCompound = 16;
+         }
+         return packet;
+      }
+
+      // all cars at lap (1 based) in sector (0..2), the times of the completed sectors and laps set
+      PacketLapData Lap(int lap, int sector)
+      {
+         PacketLapData packet{};
+         packet.m_header = Header(2, time, frame);
+         for (int i = 0; i < F12020_MAX_CARS; ++i)
+         {
+            auto& car = packet.m_lapData[i];
+            car.m_carPosition = static_cast<uint8>(i + 1);
+            car.m_currentLapNum = static_cast<uint8>(lap);
+            car.m_sector = static_cast<uint8>(sector);
+            car.m_sector1TimeInMS = (sector > 0) ? static_cast<uint16>(SectorTime(i, 0) * 1000) : 0;
+            car.m_sector2TimeInMS = (sector > 1) ? static_cast<uint16>(SectorTime(i, 1) * 1000) : 0;
+            car.m_lastLapTime = (lap > 1) ? LapTime(i) : 0;
+            car.m_bestLapTime = car.m_lastLapTime;
+            car.m_driverStatus = 4;
+            car.m_resultStatus = 2;
+         }
+         return packet;
+      }
+
+      void Feed(F12020SessionEngine& engine, const std::vector<uint8_t>& packet)
+      {
+         engine.ProceedPacket(packet.data(), static_cast<unsigned>(packet.size()));
+      }
+
+      // start the session and drive the given number of laps (sector by sector)
+      void Drive(F12020SessionEngine& engine, int laps)
+      {
+         Feed(engine, Buffer(Session()));
+         Feed(engine, Buffer(Participants()));
+         Feed(engine, Buffer(Status()));
+         for (int lap = 1; lap <= laps; ++lap)
+         {
+            for (int sector = 0; sector < F12020_SECTORS; ++sector)
+            {
+               time += 30;
+               ++frame;
+               Feed(engine, Buffer(Lap(lap, sector)));
+            }
+         }
+         engine.FlushFrame();
+      }
+   };
+
+   // ProceedPacket and the derivation of its frame, as if the packet were the only one of the frame
+   void Proceed(F12020SessionEngine& engine, const std::vector<uint8_t>& packet)
+   {
+      engine.ProceedPacket(packet.data(), static_cast<unsigned>(packet.size()));
+      engine.FlushFrame();
+   }
+
+   void BenchProceedPacket(int iterations)
+   {
+      Section("ProceedPacket per packet id (race, 22 cars, 20 laps driven)");
+
+      SyntheticSession session{ RACE };
+      std::unique_ptr<F12020SessionEngine> engine(new F12020SessionEngine());
+      session.Drive(*engine, 20);
+
+      // packets which keep the state stable, only the contents which are not interpreted vary
+      std::mt19937 rnd(2020);
+      std::vector<std::vector<uint8_t>> packets[9];
+      for (int i = 0; i < PACKETS; ++i)
+      {
+         PacketMotionData motion;
+         Randomize(&motion, sizeof(motion), rnd);
+         motion.m_header = Header(0, session.time, session.frame);
+         packets[0].push_back(Buffer(motion));
+
+         packets[1].push_back(Buffer(session.Session()));
+         packets[2].push_back(Buffer(session.Lap(21, 0)));
+         packets[4].push_back(Buffer(session.Participants()));
+
+         PacketCarSetupData setups;
+         Randomize(&setups, sizeof(setups), rnd);
+         setups.m_header = Header(5, session.time, session.frame);
+         packets[5].push_back(Buffer(setups));
+
+         PacketCarTelemetryData telemetry;
+         Randomize(&telemetry, sizeof(telemetry), rnd);
+         telemetry.m_header = Header(6, session.time, session.frame);
+         packets[6].push_back(Buffer(telemetry));
+
+         PacketCarStatusData status;
+         Randomize(&status, sizeof(status), rnd);
+         status.m_header = Header(7, session.time, session.frame);
+         packets[7].push_back(Buffer(status));
+
+         PacketFinalClassificationData classification;
+         Randomize(&classification, sizeof(classification), rnd);
+         classification.m_header = Header(8, session.time, session.frame);
+         classification.m_numCars = F12020_MAX_CARS;
+         packets[8].push_back(Buffer(classification));
+      }
+
+      const char* names[9] = { "motion", "session", "lap", "event", "participants", "setups", "telemetry", "status", "classification" };
+      for (int id = 0; id < 9; ++id)
+      {
+         if (packets[id].empty())
+            continue; // events: see BenchEvents
+
+         auto& set = packets[id];
+         double ns = Measure([&](int i) { Proceed(*engine, set[i % PACKETS]); }, iterations);
+         Report(std::string("proceed/") + names[id], ns);
+      }
+
+      // motion and setups are not subscribed by the engine, the same packets subscribed (kept header only) and read
+      engine->parser.subscriptions = F12020_PACKETS_ALL;
+      for (int id : { 0, 5 })
+      {
+         auto& set = packets[id];
+         double ns = Measure([&](int i) { Proceed(*engine, set[i % PACKETS]); }, iterations);
+         Report(std::string("proceed/") + names[id] + "_subscribed", ns);
+      }
+
+      double ns = Measure([&](int i)
+      {
+         Proceed(*engine, packets[0][i % PACKETS]);
+         s_sink = engine->parser.Motion()->m_carMotionData[0].m_worldPositionX != 0;
+      }, iterations);
+      Report("proceed/motion_materialized", ns);
+      engine->parser.subscriptions = F12020_ENGINE_PACKETS;
+   }
+
+   void BenchEvents(int iterations)
+   {
+      Section("event dispatch (race, 22 cars, 20 laps driven)");
+
+      SyntheticSession session{ RACE };
+      std::unique_ptr<F12020SessionEngine> engine(new F12020SessionEngine());
+      session.Drive(*engine, 20);
+      const size_t journal = engine->events.size();
+
+      // SSTA clears the session and is not measured
+      const char* codes[] = { "SEND", "FTLP", "RTMT", "DRSE", "DRSD", "TMPT", "CHQF", "RCWN", "PENA", "SPTP" };
+      for (const char* code : codes)
+      {
+         std::vector<std::vector<uint8_t>> packets;
+         for (int i = 0; i < PACKETS; ++i)
+         {
+            PacketEventData event{};
+            event.m_header = Header(3, session.time, session.frame);
+            memcpy(event.m_eventStringCode, code, 4);
+            event.m_eventDetails.Penalty.penaltyType = 4; // time penalty, no pit stop bookkeeping
+            event.m_eventDetails.Penalty.vehicleIdx = static_cast<uint8>(i % F12020_MAX_CARS);
+            event.m_eventDetails.Penalty.lapNum = 20;
+            packets.push_back(Buffer(event));
+         }
+
+         double ns = Measure([&](int i)
+         {
+            const auto& p = packets[i % PACKETS];
+            engine->ProceedPacket(p.data(), static_cast<unsigned>(p.size()));
+            engine->events.resize(journal); // keep the journal from growing
+         }, iterations);
+         Report(std::string("event/") + code, ns);
+      }
+   }
+
+   void BenchLapBookkeeping(int iterations)
+   {
+      Section("lap bookkeeping (race, 22 cars, one lap packet per sector crossing of all cars)");
+
+      // 100 laps of sector crossings, replayed from the state after the session start
+      SyntheticSession session{ RACE };
+      std::unique_ptr<F12020SessionEngine> engine(new F12020SessionEngine());
+      session.Drive(*engine, 0);
+
+      std::vector<uint8_t> start;
+      engine->SaveState(start);
+
+      std::vector<std::vector<uint8_t>> stream;
+      for (int lap = 1; lap <= 100; ++lap)
+         for (int sector = 0; sector < F12020_SECTORS; ++sector)
+            stream.push_back(Buffer(session.Lap(lap, sector)));
+
+      double ns = Measure([&](int i)
+      {
+         const size_t n = i % stream.size();
+         if (!n)
+            engine->RestoreState(start.data(), static_cast<unsigned>(start.size()));
+         Proceed(*engine, stream[n]);
+      }, iterations);
+      Report("laps/sector_crossing", ns);
+   }
+
+   void BenchFrames(int iterations)
+   {
+      Section("frame assembly (race, 22 cars, motion + lap + telemetry + status per frame)");
+
+      SyntheticSession session{ RACE };
+      std::unique_ptr<F12020SessionEngine> engine(new F12020SessionEngine());
+      session.Drive(*engine, 20);
+
+      std::mt19937 rnd(2020);
+      PacketMotionData motion;
+      PacketCarTelemetryData telemetry;
+      PacketCarStatusData status;
+      Randomize(&motion, sizeof(motion), rnd);
+      Randomize(&telemetry, sizeof(telemetry), rnd);
+      Randomize(&status, sizeof(status), rnd);
+      motion.m_header = Header(0, session.time, session.frame);
+      telemetry.m_header = Header(6, session.time, session.frame);
+      status.m_header = Header(7, session.time, session.frame);
+
+      std::vector<std::vector<uint8_t>> frame = { Buffer(motion), Buffer(session.Lap(21, 0)), Buffer(telemetry), Buffer(status) };
+
+      for (bool batched : { true, false })
+      {
+         double ns = Measure([&](int i)
+         {
+            const uint32_t id = session.frame + 1 + i;
+            for (auto& packet : frame)
+            {
+               memcpy(packet.data() + offsetof(PacketHeader, m_frameIdentifier), &id, sizeof(id));
+               engine->ProceedPacket(packet.data(), static_cast<unsigned>(packet.size()));
+               if (!batched)
+                  engine->FlushFrame(); // derive after every packet
+            }
+         }, iterations);
+         Report(batched ? "frame/batched" : "frame/per_packet", ns);
+         session.frame += iterations + iterations / 10 + 1;
+      }
+   }
+
+   void BenchChanges(int iterations)
+   {
+      Section("change sets (race, 22 cars)");
+
+      SyntheticSession session{ RACE };
+      std::unique_ptr<F12020SessionEngine> engine(new F12020SessionEngine());
+      session.Drive(*engine, 20);
+
+      // a second state one lap later, collecting alternately from both reports changes for all cars
+      std::unique_ptr<F12020SessionEngine> later(new F12020SessionEngine());
+      std::vector<uint8_t> state;
+      engine->SaveState(state);
+      later->RestoreState(state.data(), static_cast<unsigned>(state.size()));
+      ++session.frame;
+      Proceed(*later, Buffer(session.Lap(21, 1)));
+
+      std::unique_ptr<F12020EngineSnapshot> snapshot(new F12020EngineSnapshot());
+      std::unique_ptr<F12020EngineSnapshot> laterSnapshot(new F12020EngineSnapshot());
+      snapshot->Capture(*engine);
+      laterSnapshot->Capture(*later);
+
+      F12020ChangeTracker tracker;
+      F12020ChangeSet changes;
+      tracker.Collect(*snapshot, changes);
+
+      double ns = Measure([&](int) { tracker.Collect(*snapshot, changes); s_sink = changes.cars; }, iterations);
+      Report("changes/collect_unchanged", ns);
+
+      ns = Measure([&](int i) { tracker.Collect((i & 1) ? *snapshot : *laterSnapshot, changes); s_sink = changes.cars; }, iterations);
+      Report("changes/collect_changed", ns);
+   }
+
+   void BenchSnapshots(int iterations)
+   {
+      Section("state snapshots (race, 22 cars, engine thread publishes, UI thread reads)");
+
+      SyntheticSession session{ RACE };
+      std::unique_ptr<F12020SessionEngine> engine(new F12020SessionEngine());
+      session.Drive(*engine, 20);
+
+      F12020SnapshotBuffer buffer;
+      std::unique_ptr<F12020EngineSnapshot> snapshot(new F12020EngineSnapshot());
+      F12020SnapshotHistory history;
+      uint64_t sequence = 0;
+
+      double ns = Measure([&](int) { buffer.Publish(*engine); }, iterations);
+      Report("snapshot/publish", ns);
+
+      ns = Measure([&](int) { buffer.Publish(*engine); s_sink = buffer.Read(*snapshot, history, sequence); }, iterations);
+      Report("snapshot/publish_read", ns);
+
+      ns = Measure([&](int) { s_sink = buffer.Read(*snapshot, history, sequence); }, iterations);
+      Report("snapshot/read_unchanged", ns);
+      if (!s_json)
+         printf("  (%zu bytes per snapshot)\n", sizeof(F12020EngineSnapshot));
+   }
+
+   void BenchDeltas(int iterations)
+   {
+      Section("delta + gap update (22 cars, lap packet at a given race / qualifying length)");
+
+      const int laps[] = { 1, 10, 50, 99, 150 };
+      for (int sessionType : { RACE, Q1 })
+      {
+         for (int n : laps)
+         {
+            SyntheticSession session{ sessionType };
+            std::unique_ptr<F12020SessionEngine> engine(new F12020SessionEngine());
+            session.Drive(*engine, n);
+
+            const auto packet = Buffer(session.Lap(n + 1, 0));
+            double ns = Measure([&](int) { Proceed(*engine, packet); }, iterations);
+            Report(std::string(sessionType == RACE ? "delta/race/" : "delta/quali/") + std::to_string(n) + "_laps", ns);
+         }
+      }
+   }
+
+   // driver name resolution of F12020UdpClrMapper::m_UpdateDriverName with native names (managed, not benchmarkable here).
+   // linear: the former two passes, team + number first, number only second.
+   // indexed: F12020DriverNameIndex, the tables of adjsw::F12020::DriverNameIndex, built once per mapping load.
+   struct NameMapping
+   {
+      bool hasTeam;
+      uint8_t team;
+      uint8_t number;
+      const char* name;
+   };
+
+   const char* ResolveName(const std::vector<NameMapping>& mappings, uint8_t team, uint8_t number)
+   {
+      for (const auto& mapping : mappings)
+      {
+         if (mapping.hasTeam && (mapping.team == team) && (mapping.number == number))
+            return mapping.name;
+      }
+
+      for (const auto& mapping : mappings)
+      {
+         if (!mapping.hasTeam && (mapping.number == number))
+            return mapping.name;
+      }
+      return nullptr;
+   }
+
+   // the name of the mapping the index finds, like adjsw::F12020::DriverNameIndex::Find
+   const char* FindName(const std::vector<NameMapping>& mappings, const F12020DriverNameIndex& index, uint8_t team, uint8_t number)
+   {
+      const int32_t position = index.Find(team, number);
+      return (position != F12020_NAME_NONE) ? mappings[position].name : nullptr;
+   }
+
+   void BuildIndex(F12020DriverNameIndex& index, const std::vector<NameMapping>& mappings)
+   {
+      index = F12020DriverNameIndex{};
+      for (size_t i = 0; i < mappings.size(); ++i)
+         index.Add(static_cast<int32_t>(i), mappings[i].hasTeam, mappings[i].team, mappings[i].number);
+   }
+
+   void BenchNameResolution(int iterations)
+   {
+      Section("driver name resolution, all 22 cars (linear scan vs. index of the league mapping)");
+
+      std::mt19937 rnd(2020);
+      for (int size : { 20, 100, 500 })
+      {
+         std::vector<NameMapping> mappings;
+         for (int i = 0; i < size; ++i)
+            mappings.push_back(NameMapping{ (i % 2) == 0, static_cast<uint8_t>(i % 10), static_cast<uint8_t>(rnd() % 100), "Name" });
+
+         size_t found = 0;
+         double ns = Measure([&](int i)
+         {
+            for (int car = 0; car < F12020_MAX_CARS; ++car)
+               found += ResolveName(mappings, static_cast<uint8_t>(car / 2), static_cast<uint8_t>((car * 7 + i) % 100)) != nullptr;
+         }, iterations / 10);
+         Report("names/" + std::to_string(size) + "_mappings", ns);
+
+         std::unique_ptr<F12020DriverNameIndex> index(new F12020DriverNameIndex());
+         BuildIndex(*index, mappings);
+         size_t foundIndexed = 0;
+         ns = Measure([&](int i)
+         {
+            for (int car = 0; car < F12020_MAX_CARS; ++car)
+               foundIndexed += FindName(mappings, *index, static_cast<uint8_t>(car / 2), static_cast<uint8_t>((car * 7 + i) % 100)) != nullptr;
+         }, iterations / 10);
+         Report("names/" + std::to_string(size) + "_mappings_indexed", ns);
+
+         ns = Measure([&](int) { BuildIndex(*index, mappings); }, iterations / 100);
+         Report("names/" + std::to_string(size) + "_mappings_build", ns);
+         s_sink = found + foundIndexed;
+      }
+   }
+
+   struct WheelPackets
+   {
+      PacketCarTelemetryData telemetry;
+      PacketCarStatusData status;
+   };
+
+   struct WheelOutput
+   {
+      F12020WheelsU16 tyreInnerTemp;
+      F12020WheelsU16 tyreSurfaceTemp;
+      F12020WheelsU16 brakeTemp;
+      F12020WheelsU8 tyreWear;
+      F12020WheelsU8 tyreDamage;
+   };
+
+   template<bool batch>
+   void DecodeWheels(WheelOutput& out, const WheelPackets& in)
+   {
+      constexpr size_t tel = offsetof(PacketCarTelemetryData, m_carTelemetryData);
+      constexpr size_t sta = offsetof(PacketCarStatusData, m_carStatusData);
+      const uint8_t* inner = Bytes(in.telemetry, tel + offsetof(CarTelemetryData, m_tyresInnerTemperature));
+      const uint8_t* surface = Bytes(in.telemetry, tel + offsetof(CarTelemetryData, m_tyresSurfaceTemperature));
+      const uint8_t* brake = Bytes(in.telemetry, tel + offsetof(CarTelemetryData, m_brakesTemperature));
+      const uint8_t* wear = Bytes(in.status, sta + offsetof(CarStatusData, m_tyresWear));
+      const uint8_t* damage = Bytes(in.status, sta + offsetof(CarStatusData, m_tyresDamage));
+
+      if (batch)
+      {
+         F12020DecodeWheels8To16(out.tyreInnerTemp, inner, sizeof(CarTelemetryData));
+         F12020DecodeWheels8To16(out.tyreSurfaceTemp, surface, sizeof(CarTelemetryData));
+         F12020DecodeWheels16(out.brakeTemp, brake, sizeof(CarTelemetryData));
+         F12020DecodeWheels8(out.tyreWear, wear, sizeof(CarStatusData));
+         F12020DecodeWheels8(out.tyreDamage, damage, sizeof(CarStatusData));
+      }
+      else
+      {
+         F12020DecodeWheels8To16Scalar(out.tyreInnerTemp, inner, sizeof(CarTelemetryData));
+         F12020DecodeWheels8To16Scalar(out.tyreSurfaceTemp, surface, sizeof(CarTelemetryData));
+         F12020DecodeWheels16Scalar(out.brakeTemp, brake, sizeof(CarTelemetryData));
+         F12020DecodeWheels8Scalar(out.tyreWear, wear, sizeof(CarStatusData));
+         F12020DecodeWheels8Scalar(out.tyreDamage, damage, sizeof(CarStatusData));
+      }
+   }
+
+   void BenchWheelDecode(int iterations)
+   {
+      Section("wheel decode (telemetry + status, 22 cars, 5 arrays)");
+
+      std::vector<WheelPackets> packets(PACKETS);
+      std::mt19937 rnd(2020);
+      for (auto& p : packets)
+         Randomize(&p, sizeof(p), rnd);
+
+      WheelOutput out{};
+      uint32_t checksum = 0;
+      auto sum = [&]() { checksum += out.tyreInnerTemp[0][0] + out.brakeTemp[3][21] + out.tyreWear[2][11]; };
+
+      double scalar = Measure([&](int i) { DecodeWheels<false>(out, packets[i % PACKETS]); sum(); }, iterations);
+      double batch = Measure([&](int i) { DecodeWheels<true>(out, packets[i % PACKETS]); sum(); }, iterations);
+
+      Report("wheels/per_field", scalar);
+      Report("wheels/batch", batch);
+      if (!s_json)
+         printf("  (%s, %.2fx, checksum %u)\n", F12020WheelDecoderIsa(), scalar / batch, checksum);
+   }
+
+   void PrintJson(int iterations)
+   {
+      printf("{\n  \"iterations\": %d,\n  \"wheel_isa\": \"%s\",\n  \"unit\": \"ns\",\n  \"results\": {\n", iterations, F12020WheelDecoderIsa());
+      for (size_t i = 0; i < s_results.size(); ++i)
+         printf("    \"%s\": %.2f%s\n", s_results[i].name.c_str(), s_results[i].ns, (i + 1 < s_results.size()) ? "," : "");
+      printf("  }\n}\n");
+   }
+}
+
+int main(int argc, char* argv[])
+{
+   int iterations = 1000000;
+   for (int i = 1; i < argc; ++i)
+   {
+      if (!strcmp(argv[i], "--json"))
+         s_json = true;
+      else
+         iterations = atoi(argv[i]);
+   }
+   if (iterations < 10)
+      iterations = 10;
+
+   BenchProceedPacket(iterations);
+   BenchEvents(iterations);
+   BenchLapBookkeeping(iterations);
+   BenchFrames(iterations);
+   BenchChanges(iterations);
+   BenchSnapshots(iterations);
+   BenchDeltas(iterations);
+   BenchNameResolution(iterations);
+   BenchWheelDecode(iterations);
+
+   if (s_json)
+      PrintJson(iterations);
+   return 0;
+}
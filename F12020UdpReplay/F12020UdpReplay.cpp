@@ -0,0 +1,338 @@
+// Copyright 2018-2021 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+// Headless replay of a capture file (see F12020Capture.h) through F12020SessionEngine.
+// usage: F12020UdpReplay <capture.f1cap> [speed] [repeat]
+//   speed: "max" (default) replays unthrottled, a number paces the packets at that multiple of the recorded time (1 = real time)
+//   repeat: number of passes, each one with a fresh engine
+// Reports the throughput, the parse time per packet id, the peak memory and a digest of the final state,
+// which must be identical for all runs of the same capture with the same build.
+// usage: F12020UdpReplay <capture.f1cap> seek [count]
+//   seeks to count random session times via the keyframes, reports the seek times and checks each state against a linear replay
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <thread>
+#include "F12020Capture.h"
+#include "F12020SessionEngine.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+   constexpr int PACKET_IDS = 10; // F1 2020 packet ids 0..9
+
+   const char* const PACKET_NAMES[PACKET_IDS] =
+   {
+      "motion", "session", "lap", "event", "participants", "setups", "telemetry", "status", "classification", "lobby"
+   };
+
+   struct PacketStats
+   {
+      uint64_t count;
+      uint64_t bytes;
+      double ns;
+      double maxNs;
+   };
+
+   struct ReplayResult
+   {
+      PacketStats packets[PACKET_IDS];
+      PacketStats invalid; // unknown packet id or too short
+      uint64_t total;
+      double seconds;      // wall time of the pass, including the pacing
+      double parseSeconds; // time spent in ProceedPacket
+      uint64_t digest;
+      size_t events;          // journaled at the end
+      uint32_t eventsDropped; // beyond F12020_MAX_EVENTS
+   };
+
+   uint64_t Fnv(uint64_t hash, const void* pData, size_t len)
+   {
+      const uint8_t* p = static_cast<const uint8_t*>(pData);
+      for (size_t i = 0; i < len; ++i)
+      {
+         hash ^= p[i];
+         hash *= 0x100000001b3ull;
+      }
+      return hash;
+   }
+
+   template<typename T>
+   uint64_t Fnv(uint64_t hash, const T& value)
+   {
+      return Fnv(hash, &value, sizeof(value));
+   }
+
+   // hash of the derived state, field by field to skip any padding
+   uint64_t Digest(const F12020SessionEngine& engine)
+   {
+      uint64_t hash = 0xcbf29ce484222325ull;
+      hash = Fnv(hash, engine.session.track);
+      hash = Fnv(hash, engine.session.sessionType);
+      hash = Fnv(hash, engine.session.currentLap);
+      hash = Fnv(hash, engine.session.countDrivers);
+      hash = Fnv(hash, engine.session.leaderIdx);
+
+      for (int i = 0; i < F12020_MAX_CARS; ++i)
+      {
+         const auto& car = engine.drivers[i];
+         hash = Fnv(hash, car.present);
+         hash = Fnv(hash, car.status);
+         hash = Fnv(hash, car.pos);
+         hash = Fnv(hash, car.lapNr);
+         hash = Fnv(hash, car.tyreAge);
+         hash = Fnv(hash, car.penaltySeconds);
+         hash = Fnv(hash, car.fastestLap);
+         hash = Fnv(hash, car.timedeltaToPlayer);
+         hash = Fnv(hash, car.timedeltaToLeader);
+         hash = Fnv(hash, car.visualTyres, car.numVisualTyres);
+         hash = Fnv(hash, car.numPitPenalties);
+         for (int lapNr = 1; lapNr <= car.lapNr; ++lapNr)
+            hash = Fnv(hash, engine.laps.Lap(i, lapNr));
+      }
+
+      for (const auto& event : engine.events)
+      {
+         hash = Fnv(hash, event.type);
+         hash = Fnv(hash, event.carIndex);
+         hash = Fnv(hash, event.sessionTime);
+         hash = Fnv(hash, event.penaltyServed);
+         hash = Fnv(hash, event.lapTime);
+         hash = Fnv(hash, event.speed);
+      }
+
+      hash = Fnv(hash, engine.classification, engine.classifiedCars * sizeof(engine.classification[0]));
+      return hash;
+   }
+
+   ReplayResult Replay(F12020CaptureReader& reader, double speed)
+   {
+      ReplayResult result{};
+      std::unique_ptr<F12020SessionEngine> engine(new F12020SessionEngine());
+
+      reader.Rewind();
+      F12020CapturePacket packet;
+      int64_t firstTimestamp = 0;
+      const auto start = std::chrono::steady_clock::now();
+
+      while (reader.Next(packet))
+      {
+         if (speed > 0)
+         {
+            if (!result.total)
+               firstTimestamp = packet.timestampNs;
+
+            const auto due = start + std::chrono::nanoseconds(static_cast<int64_t>((packet.timestampNs - firstTimestamp) / speed));
+            if (due > std::chrono::steady_clock::now())
+               std::this_thread::sleep_until(due);
+         }
+
+         const auto t0 = std::chrono::steady_clock::now();
+         engine->ProceedPacket(packet.data, packet.len);
+         const auto t1 = std::chrono::steady_clock::now();
+         const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+
+         // unsubscribed packets count for their id, i.e. the cost of skipping them
+         const bool known = engine->parser.lastPacket || engine->parser.skipped;
+         const uint8_t packetId = known ? reinterpret_cast<const PacketHeader*>(packet.data)->m_packetId : PACKET_IDS;
+         PacketStats& stats = packetId < PACKET_IDS ? result.packets[packetId] : result.invalid;
+         ++stats.count;
+         stats.bytes += packet.len;
+         stats.ns += ns;
+         if (ns > stats.maxNs)
+            stats.maxNs = ns;
+
+         result.parseSeconds += ns * 1e-9;
+         ++result.total;
+      }
+
+      engine->FlushFrame(); // the last frame of the capture
+      result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      result.digest = Digest(*engine);
+      result.events = engine->events.size();
+      result.eventsDropped = engine->eventsDropped;
+      return result;
+   }
+
+   double PeakMemoryMB()
+   {
+#ifdef _WIN32
+      PROCESS_MEMORY_COUNTERS counters{};
+      if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+         return 0;
+      return counters.PeakWorkingSetSize / (1024.0 * 1024.0);
+#else
+      rusage usage{};
+      if (getrusage(RUSAGE_SELF, &usage))
+         return 0;
+      return usage.ru_maxrss / 1024.0; // kB on Linux
+#endif
+   }
+
+   // reference for the seek: restore the first keyframe of the session (the capture may start in the middle of it)
+   // and replay all packets up to the first one of the session past sessionTime
+   bool ReplayUntil(F12020CaptureReader& reader, F12020SessionEngine& engine, uint64_t sessionUID, float sessionTime)
+   {
+      const F12020CaptureKeyframeEntry* first = reader.FindKeyframe(sessionUID, -1);
+      if (!first || !reader.RestoreKeyframe(*first, engine))
+         return false;
+
+      F12020CapturePacket packet;
+      while (reader.Next(packet))
+      {
+         const auto* header = reinterpret_cast<const PacketHeader*>(packet.data);
+         if ((packet.len >= sizeof(PacketHeader)) && (header->m_sessionUID == sessionUID) && (header->m_sessionTime > sessionTime))
+            break;
+         engine.ProceedPacket(packet.data, packet.len);
+      }
+      engine.FlushFrame();
+      return true;
+   }
+
+   int Seek(F12020CaptureReader& reader, int count)
+   {
+      const auto& keyframes = reader.Keyframes();
+      printf("seek (%zu keyframes)\n", keyframes.size());
+      if (keyframes.empty())
+      {
+         printf("  the capture has no keyframes\n");
+         return 1;
+      }
+
+      std::mt19937 rnd(2020);
+      double totalMs = 0;
+      double maxMs = 0;
+      double linearMs = 0;
+      int mismatches = 0;
+
+      for (int i = 0; i < count; ++i)
+      {
+         // a random time within the span of the keyframes of a random session
+         const F12020CaptureKeyframe& pick = keyframes[rnd() % keyframes.size()].keyframe;
+         float first = pick.sessionTime;
+         float last = pick.sessionTime;
+         for (const auto& entry : keyframes)
+         {
+            if (entry.keyframe.sessionUID != pick.sessionUID)
+               continue;
+            first = std::min(first, entry.keyframe.sessionTime);
+            last = std::max(last, entry.keyframe.sessionTime);
+         }
+         const float sessionTime = first + std::uniform_real_distribution<float>(0, last - first + F12020_CAPTURE_KEYFRAME_INTERVAL)(rnd);
+
+         std::unique_ptr<F12020SessionEngine> engine(new F12020SessionEngine());
+         auto t0 = std::chrono::steady_clock::now();
+         if (!reader.SeekSessionTime(*engine, pick.sessionUID, sessionTime))
+         {
+            printf("  seek to %.3f failed\n", sessionTime);
+            return 2;
+         }
+         const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+         totalMs += ms;
+         maxMs = std::max(maxMs, ms);
+
+         std::unique_ptr<F12020SessionEngine> reference(new F12020SessionEngine());
+         t0 = std::chrono::steady_clock::now();
+         const bool replayed = ReplayUntil(reader, *reference, pick.sessionUID, sessionTime);
+         linearMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+         if (!replayed || (Digest(*engine) != Digest(*reference)))
+         {
+            printf("  state after seek to %.3f differs from the linear replay\n", sessionTime);
+            ++mismatches;
+         }
+      }
+
+      printf("  seeks     : %d, %.2f ms average, %.2f ms max\n", count, totalMs / count, maxMs);
+      printf("  linear    : %.2f ms average\n", linearMs / count);
+      printf("  peak mem  : %.1f MB (including the mapped capture)\n", PeakMemoryMB());
+      return mismatches ? 2 : 0;
+   }
+
+   void Print(const ReplayResult& result, const F12020CaptureReader& reader)
+   {
+      printf("  packets   : %llu in %.3f s, %.0f packets/s\n", static_cast<unsigned long long>(result.total), result.seconds,
+         result.seconds > 0 ? result.total / result.seconds : 0);
+      printf("  parsing   : %.3f s, %.0f packets/s, %.1f ns/packet\n", result.parseSeconds,
+         result.parseSeconds > 0 ? result.total / result.parseSeconds : 0, result.total ? result.parseSeconds * 1e9 / result.total : 0);
+
+      printf("  %-15s %10s %12s %10s %10s\n", "packet", "count", "bytes", "ns/packet", "max ns");
+      auto row = [](const char* name, const PacketStats& stats)
+      {
+         if (stats.count)
+            printf("  %-15s %10llu %12llu %10.1f %10.0f\n", name, static_cast<unsigned long long>(stats.count),
+               static_cast<unsigned long long>(stats.bytes), stats.ns / stats.count, stats.maxNs);
+      };
+      for (int i = 0; i < PACKET_IDS; ++i)
+         row(PACKET_NAMES[i], result.packets[i]);
+      row("invalid", result.invalid);
+      printf("  events    : %zu journaled, %u dropped (journal full)\n", result.events, result.eventsDropped);
+
+      printf("  capture   : %.1f MB%s\n", reader.Size() / (1024.0 * 1024.0), reader.Complete() ? "" : " (not closed, index rebuilt)");
+      printf("  peak mem  : %.1f MB (including the mapped capture)\n", PeakMemoryMB());
+      printf("  digest    : %016llx\n", static_cast<unsigned long long>(result.digest));
+   }
+}
+
+int main(int argc, char* argv[])
+{
+   if (argc < 2)
+   {
+      printf("usage: F12020UdpReplay <capture.f1cap> [speed|max] [repeat]\n");
+      printf("       F12020UdpReplay <capture.f1cap> seek [count]\n");
+      return 1;
+   }
+
+   F12020CaptureReader reader;
+   if (!reader.Open(argv[1]))
+   {
+      printf("%s: not a readable capture\n", argv[1]);
+      return 1;
+   }
+
+   int repeat = 1;
+   if (argc > 3)
+      repeat = atoi(argv[3]);
+   if (repeat < 1)
+      repeat = 1;
+
+   if ((argc > 2) && !strcmp(argv[2], "seek"))
+      return Seek(reader, argc > 3 ? repeat : 20);
+
+   double speed = 0;
+   if ((argc > 2) && strcmp(argv[2], "max"))
+      speed = atof(argv[2]);
+
+   uint64_t digest = 0;
+   for (int pass = 0; pass < repeat; ++pass)
+   {
+      if (speed > 0)
+         printf("pass %d (%.2fx real time)\n", pass + 1, speed);
+      else
+         printf("pass %d (unthrottled)\n", pass + 1);
+
+      ReplayResult result = Replay(reader, speed);
+      Print(result, reader);
+
+      if (pass && (result.digest != digest))
+      {
+         printf("replay is not deterministic!\n");
+         return 2;
+      }
+      digest = result.digest;
+   }
+
+   return 0;
+}
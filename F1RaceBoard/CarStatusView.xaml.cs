@@ -1,18 +1,18 @@
-﻿// Copyright 2018-2020 Andreas Jung
-// SPDX-License-Identifier: GPL-3.0-only
-
-using System.Windows.Controls;
-
-namespace adjsw.F12020
-{
-    /// <summary>
-    /// Interaktionslogik für CarStatusView.xaml
-    /// </summary>
-    public partial class CarStatusView : UserControl
-    {
-        public CarStatusView()
-        {
-            InitializeComponent();
-        }
-    }
-}
+// Copyright 2018-2020 Andreas Jung
+// SPDX-License-Identifier: GPL-3.0-only
+
+using System.Windows.Controls;
+
+namespace adjsw.F12020
+{
+    /// <summary>
+    /// Interaktionslogik für CarStatusView.xaml
+    /// </summary>
+    public partial class CarStatusView : UserControl
+    {
+        public CarStatusView()
+        {
+            InitializeComponent();
+        }
+    }
+}